@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "cppdbc/sqlite/sqlite_database.hpp"
+
+using namespace cppdbc;
+
+namespace {
+
+constexpr int64_t ROWS = 1000;
+constexpr int64_t ITERATIONS = 200000;
+
+/**
+ * @brief Run benchmark.
+ *
+ * Run point lookups by primary key in an in-memory database opened with the
+ * given threading mode. Each lookup binds, steps, reads and resets the
+ * statement, so each call into SQLite locks the connection mutex unless the
+ * connection is in multi-thread mode.
+ *
+ * @param[in] threading Threading mode of the connection.
+ *
+ * @return Average time of a lookup, in nanoseconds.
+ */
+double run(SQLiteDatabase::ThreadingMode threading) {
+    SQLiteDatabase::OpenOptions options;
+    options.mode = SQLiteDatabase::SQLiteMode::IN_MEMORY;
+    options.threading = threading;
+
+    auto database = std::make_shared<SQLiteDatabase>(":memory:", options);
+
+    database->execute_script(
+            "CREATE TABLE numbers (id INTEGER PRIMARY KEY, value INTEGER, name TEXT);"
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < " +
+            std::to_string(ROWS) + ")"
+            "INSERT INTO numbers SELECT n, n * 2, 'name-' || n FROM seq;");
+
+    auto statement = database->create_statement(
+            "SELECT value, name FROM numbers WHERE id = ?");
+
+    int64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        statement->bind(i % ROWS + 1, 0);
+
+        auto cursor = statement->query();
+
+        if (cursor) {
+            checksum += cursor->int64(0);
+            checksum += static_cast<int64_t>(cursor->text_view(1).size());
+        }
+
+        statement->reset();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (checksum == 0) {
+        std::fprintf(stderr, "Unexpected checksum\n");
+    }
+
+    return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ITERATIONS;
+}
+
+} // namespace
+
+int main() {
+    // Warm up the allocator and the CPU caches before measuring
+    run(SQLiteDatabase::ThreadingMode::SERIALIZED);
+
+    double serialized = run(SQLiteDatabase::ThreadingMode::SERIALIZED);
+    double multi_thread = run(SQLiteDatabase::ThreadingMode::MULTI_THREAD);
+
+    std::printf("Point lookups: %lld iterations over %lld rows\n",
+            static_cast<long long>(ITERATIONS), static_cast<long long>(ROWS));
+    std::printf("  serialized (FULLMUTEX):  %8.1f ns/lookup\n", serialized);
+    std::printf("  multi-thread (NOMUTEX):  %8.1f ns/lookup\n", multi_thread);
+    std::printf("  gain:                    %8.1f %%\n",
+            (serialized - multi_thread) / serialized * 100.0);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+# Copyright (c) 2020 Gustavo Salomao
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# The column metadata functions are only available when SQLite was compiled
+# with SQLITE_ENABLE_COLUMN_METADATA, so the macro is defined for the sources
+# when the linked library provides them
+include_guard(GLOBAL)
+include(CheckCXXSymbolExists)
+include(CMakePushCheckState)
+
+find_package(SQLite3 REQUIRED)
+
+cmake_push_check_state(RESET)
+set(CMAKE_REQUIRED_INCLUDES ${SQLite3_INCLUDE_DIRS})
+set(CMAKE_REQUIRED_LIBRARIES ${SQLite3_LIBRARIES})
+set(CMAKE_REQUIRED_QUIET YES)
+check_cxx_symbol_exists(sqlite3_column_table_name sqlite3.h
+  CPPDBC_SQLITE_COLUMN_METADATA)
+cmake_pop_check_state()
+
+if (CPPDBC_SQLITE_COLUMN_METADATA)
+  message(STATUS "SQLite column metadata: enabled")
+else ()
+  message(STATUS "SQLite column metadata: disabled")
+endif ()
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Arrow writer.
+ * @file
+ */
+
+#ifndef ARROW_WRITER_HPP
+#define ARROW_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "column_batch.hpp"
+#include "resultset.hpp"
+#include "statement.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Arrow writer.
+ *
+ * An Arrow writer exports result sets to the Arrow IPC stream or file
+ * format, in record batches of a bounded number of rows. The columns are
+ * written with the following Arrow types:
+ *
+ * - INTEGER: Int64.
+ * - FLOAT: Float64 (double).
+ * - TEXT: LargeUtf8.
+ * - BLOB: LargeBinary.
+ * - NULL_VALUE: Null.
+ *
+ * The data types of the columns are given by the fetched batches (see
+ * ResultSet::fetch_batch). While a column has only NULL values, the batches
+ * are held, and the schema is written once every column has a data type or
+ * the result finished. A column with only NULL values has the data type
+ * given by its declared type (see ColumnBatch::data_type), or the Arrow Null
+ * type when it has no declared type, as when a statement without rows is
+ * written. When nothing is written, the schema has no columns. A column
+ * promoted after the schema was written doesn't match the schema, and it's
+ * rejected.
+ */
+class ArrowWriter {
+public:
+    /**
+     * @brief Arrow format.
+     */
+    enum class Format {
+        STREAM,     /*!< IPC stream format (.arrows) */
+        FILE        /*!< IPC file format (.arrow), which supports random access */
+    };
+
+    /**
+     * @brief Default number of rows of each record batch.
+     */
+    static constexpr size_t DEFAULT_BATCH_ROWS = 65536;
+
+    /**
+     * @brief Create Arrow writer.
+     *
+     * Constructor of the Arrow writer.
+     *
+     * @param[in] output Output stream which the Arrow data is written.
+     * @param[in] format Arrow format.
+     */
+    explicit ArrowWriter(std::ostream& output, Format format = Format::STREAM);
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Arrow writer is not copyable.
+     */
+    ArrowWriter(const ArrowWriter&) = delete;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Arrow writer is not copyable.
+     */
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+    /**
+     * @brief Write result set.
+     *
+     * Write the current and the remaining rows of a result set in record
+     * batches. Only one batch is kept in memory at a time, unless a column
+     * has only NULL values before the schema is written. The schema is
+     * written before the first batch, and all result sets written by the
+     * same writer must have the same columns.
+     *
+     * @param[in] result Result set positioned on its first row to be written.
+     * @param[in] rows Maximum number of rows of each record batch.
+     *
+     * @return Number of written rows.
+     * @throw std::invalid_argument in case of invalid number of rows.
+     * @throw std::logic_error in case of the writer was closed, the columns
+     * don't match the schema, or failure to write the output.
+     */
+    size_t write(ResultSet& result, size_t rows = DEFAULT_BATCH_ROWS);
+
+    /**
+     * @brief Write statement.
+     *
+     * Query a statement and write all its rows in record batches. When the
+     * statement has no rows, the schema is still written from the metadata
+     * of the statement. Afterwards, the statement is reset.
+     *
+     * @param[in] statement Statement to be queried.
+     * @param[in] rows Maximum number of rows of each record batch.
+     *
+     * @return Number of written rows.
+     * @throw std::invalid_argument in case of invalid number of rows.
+     * @throw std::logic_error in case of the writer was closed, the columns
+     * don't match the schema, or failure to query the statement or to write
+     * the output.
+     */
+    size_t write(Statement& statement, size_t rows = DEFAULT_BATCH_ROWS);
+
+    /**
+     * @brief Close writer.
+     *
+     * Write the end of the stream and, for the file format, the footer. No
+     * rows can be written afterwards.
+     *
+     * @throw std::logic_error in case of failure to write the output.
+     */
+    void close();
+
+private:
+    /**
+     * @brief Location of a record batch in the file.
+     */
+    struct Block {
+        int64_t offset;
+        int32_t metadata_size;
+        int64_t body_size;
+    };
+
+    /**
+     * @brief Write schema from metadata.
+     *
+     * Write the schema of a result without rows, unless it was already
+     * written.
+     *
+     * @param[in] metadata Metadata of the result.
+     */
+    void write_schema(const ResultSetMetadata& metadata);
+
+    /**
+     * @brief Write schema.
+     *
+     * @param[in] names Names of the columns.
+     * @param[in] types Data types of the columns.
+     */
+    void write_schema(const std::vector<std::string>& names,
+            const std::vector<ResultSet::DataType>& types);
+
+    /**
+     * @brief Write record batches.
+     *
+     * Write the record batches and remove them.
+     *
+     * @param[in,out] batches Batches to be written.
+     *
+     * @throw std::logic_error in case of the columns don't match the schema.
+     */
+    void write_batches(std::vector<ColumnBatch>& batches);
+
+    /**
+     * @brief Write record batch.
+     *
+     * A column with only NULL values takes the data type of the schema, and
+     * an INTEGER column is promoted when the schema has a FLOAT column.
+     *
+     * @param[in,out] batch Batch to be written.
+     *
+     * @throw std::logic_error in case of the columns don't match the schema.
+     */
+    void write_batch(ColumnBatch& batch);
+
+    /**
+     * @brief Write encapsulated message.
+     *
+     * @param[in] metadata Flatbuffer of the message.
+     * @param[in] body Body of the message.
+     *
+     * @return Location of the message.
+     */
+    Block write_message(const std::vector<uint8_t>& metadata, const std::vector<uint8_t>& body);
+
+    /**
+     * @brief Write bytes.
+     *
+     * @param[in] data Pointer to the bytes.
+     * @param[in] size Number of bytes.
+     */
+    void write_bytes(const void* data, size_t size);
+
+    /**
+     * @brief Output stream.
+     */
+    std::ostream& output_;
+
+    /**
+     * @brief Arrow format.
+     */
+    Format format_;
+
+    /**
+     * @brief Number of written bytes.
+     */
+    int64_t position_ = 0;
+
+    /**
+     * @brief Indicates if the writer was closed.
+     */
+    bool closed_ = false;
+
+    /**
+     * @brief Indicates if the schema was written.
+     */
+    bool schema_written_ = false;
+
+    /**
+     * @brief Names of the columns of the schema.
+     */
+    std::vector<std::string> names_;
+
+    /**
+     * @brief Data types of the columns of the schema, or empty for Null.
+     */
+    std::vector<ResultSet::DataType> types_;
+
+    /**
+     * @brief Record batches written to the file.
+     */
+    std::vector<Block> blocks_;
+
+    /**
+     * @brief Batch reused to fetch the rows.
+     */
+    ColumnBatch batch_;
+
+    /**
+     * @brief Body reused to write the record batches.
+     */
+    std::vector<uint8_t> body_;
+};
+
+} // namespace cppdbc
+
+#endif // ARROW_WRITER_HPP
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief BLOB stream interface.
+ * @file
+ */
+
+#ifndef BLOB_STREAM_HPP
+#define BLOB_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cppdbc {
+
+/**
+ * @brief BLOB stream.
+ *
+ * A BLOB stream gives incremental access to a single BLOB stored in the
+ * database. The BLOB is read and written in chunks, so large objects don't
+ * need to be loaded in memory at once.
+ *
+ * @note The size of the BLOB can't be changed through the stream. To write a
+ * new BLOB, a zero-filled BLOB with the final size shall be inserted first.
+ */
+class BlobStream {
+public:
+    /**
+     * @brief Destroy BLOB stream.
+     *
+     * Destructor of the BLOB stream.
+     */
+    virtual ~BlobStream() = default;
+
+    /**
+     * @brief Get size.
+     *
+     * Get the number of bytes of the BLOB.
+     *
+     * @return Size of the BLOB.
+     */
+    [[nodiscard]] virtual size_t size() const noexcept = 0;
+
+    /**
+     * @brief Read from BLOB.
+     *
+     * Read a chunk of the BLOB starting at the given offset.
+     *
+     * @param[in] offset Offset, in bytes, from the beginning of the BLOB.
+     * @param[out] data Memory location where the chunk shall be stored.
+     * @param[in] size Number of bytes to be read.
+     *
+     * @throw std::invalid_argument in case the chunk is out of the BLOB.
+     * @throw std::logic_error in case of failure to read the BLOB.
+     */
+    virtual void read(size_t offset, void* data, size_t size) = 0;
+
+    /**
+     * @brief Write to BLOB.
+     *
+     * Write a chunk to the BLOB starting at the given offset.
+     *
+     * @param[in] offset Offset, in bytes, from the beginning of the BLOB.
+     * @param[in] data Memory location of the chunk to be written.
+     * @param[in] size Number of bytes to be written.
+     *
+     * @throw std::invalid_argument in case the chunk is out of the BLOB.
+     * @throw std::logic_error in case of failure to write the BLOB or the
+     * stream is read-only.
+     */
+    virtual void write(size_t offset, const void* data, size_t size) = 0;
+
+    /**
+     * @brief Reopen BLOB stream.
+     *
+     * Move the stream to the BLOB of another row of the same table and
+     * column, which is faster than opening a new stream.
+     *
+     * @param[in] rowid Row ID of the row which the BLOB belongs to.
+     *
+     * @throw std::invalid_argument in case of invalid row.
+     */
+    virtual void reopen(int64_t rowid) = 0;
+};
+
+} // namespace cppdbc
+
+#endif // BLOB_STREAM_HPP
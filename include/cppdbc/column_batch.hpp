@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Column batch.
+ * @file
+ */
+
+#ifndef COLUMN_BATCH_HPP
+#define COLUMN_BATCH_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "resultset.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Column batch.
+ *
+ * A column batch stores many rows of a result set in column-major buffers,
+ * so the rows can be processed a column at a time. Each column stores its
+ * values in contiguous buffers according to its data type:
+ *
+ * - INTEGER: one value per row in @c integers.
+ * - FLOAT: one value per row in @c reals. When the column has INTEGER
+ *   values, they're also kept without loss in @c integers, with one value
+ *   per row, and their rows are marked in the @c integral bitmap.
+ * - TEXT and BLOB: the bytes of all rows in @c data, and the offset of each
+ *   row in @c offsets, which has one more entry than the number of rows.
+ *
+ * A NULL value is stored as zero or as empty, and its bit in the validity
+ * bitmap is cleared. The bitmaps have one bit per row, starting from the
+ * least significant bit of the first byte.
+ *
+ * A column stores the values of a single data type. Its data type is first
+ * given by the affinity of its declared type, or it's NULL_VALUE, without
+ * any value buffer, when the column has no declared type. Until the column
+ * gets a value which isn't NULL, it takes the data type of that value.
+ * Afterwards, the data type is kept, except that an INTEGER column is
+ * promoted to FLOAT when it gets a FLOAT value. Any other mix of data types
+ * can't be stored without loss, and it's rejected.
+ *
+ * @note A batch can be reused to fetch many batches of the same result. Its
+ * buffers keep their memory and its columns keep their data types, unless
+ * they are promoted. A batch filled from another result starts over with
+ * new columns.
+ */
+struct ColumnBatch {
+    /**
+     * @brief Column of the batch.
+     */
+    struct Column {
+        /**
+         * @brief Data type of the values of the column.
+         *
+         * NULL_VALUE while the column has no data type, as it has only NULL
+         * values and no declared type.
+         */
+        ResultSet::DataType type = ResultSet::DataType::NULL_VALUE;
+
+        /**
+         * @brief Indicates if the data type was given by a value.
+         *
+         * A data type given only by the declared type of the column can still
+         * be replaced by the data type of the first value which isn't NULL.
+         * It's kept when the column is cleared.
+         */
+        bool typed = false;
+
+        /**
+         * @brief Values of INTEGER columns, and INTEGER values of FLOAT
+         * columns.
+         */
+        std::vector<int64_t> integers;
+
+        /**
+         * @brief Values of FLOAT columns.
+         */
+        std::vector<double> reals;
+
+        /**
+         * @brief Offsets of the values of TEXT and BLOB columns in @c data.
+         */
+        std::vector<int64_t> offsets;
+
+        /**
+         * @brief Bytes of the values of TEXT and BLOB columns.
+         */
+        std::vector<std::byte> data;
+
+        /**
+         * @brief Validity bitmap.
+         */
+        std::vector<uint8_t> validity;
+
+        /**
+         * @brief Bitmap of the INTEGER values of FLOAT columns.
+         *
+         * Empty when the column has no INTEGER value.
+         */
+        std::vector<uint8_t> integral;
+
+        /**
+         * @brief Check if value is valid.
+         *
+         * @param[in] row Row of the value.
+         *
+         * @retval true - value is not NULL.
+         * @retval false - value is NULL.
+         */
+        [[nodiscard]] bool valid(size_t row) const noexcept {
+            return (validity[row / 8] >> (row % 8)) & 1U;
+        }
+
+        /**
+         * @brief Check if value is INTEGER.
+         *
+         * @param[in] row Row of the value.
+         *
+         * @retval true - value is an INTEGER, stored in @c integers.
+         * @retval false - value is not an INTEGER.
+         */
+        [[nodiscard]] bool has_integer(size_t row) const noexcept {
+            if (type == ResultSet::DataType::INTEGER) {
+                return valid(row);
+            }
+
+            return !integral.empty() && ((integral[row / 8] >> (row % 8)) & 1U);
+        }
+
+        /**
+         * @brief Append value to FLOAT column.
+         *
+         * @param[in] value Value which isn't INTEGER, or zero for NULL.
+         * @param[in] row Row of the value.
+         */
+        void append_real(double value, size_t row) {
+            reals.push_back(value);
+
+            if (!integral.empty()) {
+                integers.push_back(0);
+
+                if (row % 8 == 0) {
+                    integral.push_back(0);
+                }
+            }
+        }
+
+        /**
+         * @brief Append INTEGER value to FLOAT column.
+         *
+         * The value is converted to FLOAT, and also kept without loss.
+         *
+         * @param[in] value Value to append.
+         * @param[in] row Row of the value.
+         */
+        void append_integer(int64_t value, size_t row) {
+            reals.push_back(static_cast<double>(value));
+
+            if (integral.empty()) {
+                integers.assign(row, 0);
+                integral.assign((row + 7) / 8, 0);
+            }
+
+            integers.push_back(value);
+
+            if (row % 8 == 0) {
+                integral.push_back(0);
+            }
+
+            integral.back() |= static_cast<uint8_t>(1U << (row % 8));
+        }
+
+        /**
+         * @brief Get text.
+         *
+         * @param[in] row Row of the value.
+         *
+         * @return View of the text of a TEXT column.
+         */
+        [[nodiscard]] std::string_view text(size_t row) const noexcept {
+            return {reinterpret_cast<const char*>(data.data()) + offsets[row],
+                    static_cast<size_t>(offsets[row + 1] - offsets[row])};
+        }
+
+        /**
+         * @brief Get BLOB.
+         *
+         * @param[in] row Row of the value.
+         *
+         * @return View of the BLOB of a BLOB column.
+         */
+        [[nodiscard]] BlobView blob(size_t row) const noexcept {
+            return {data.data() + offsets[row],
+                    static_cast<size_t>(offsets[row + 1] - offsets[row])};
+        }
+
+        /**
+         * @brief Prepare column to store value.
+         *
+         * Make the column able to store a value of the given data type
+         * without loss. When the column takes the data type of its first
+         * value which isn't NULL, its NULL values are stored again as zero
+         * or empty, and when it's promoted to FLOAT, its values are
+         * converted and also kept as INTEGER values.
+         *
+         * @param[in] value Data type of the value to store.
+         * @param[in] rows Number of values already stored in the column.
+         *
+         * @throw std::invalid_argument in case of the column can't store the
+         * value without loss.
+         */
+        void store(ResultSet::DataType value, size_t rows) {
+            using DataType = ResultSet::DataType;
+
+            if (value == DataType::NULL_VALUE) {
+                return;
+            }
+
+            if (value == type || (value == DataType::INTEGER && type == DataType::FLOAT)) {
+                typed = true;
+                return;
+            }
+
+            if (!typed) {
+                // The column has only NULL values, which are zero or empty
+                integers.clear();
+                reals.clear();
+                offsets.assign(1, 0);
+                data.clear();
+                integral.clear();
+                type = value;
+                typed = true;
+
+                if (type == DataType::INTEGER) {
+                    integers.assign(rows, 0);
+                } else if (type == DataType::FLOAT) {
+                    reals.assign(rows, 0.0);
+                } else {
+                    offsets.assign(rows + 1, 0);
+                }
+
+                return;
+            }
+
+            if (type == DataType::INTEGER && value == DataType::FLOAT) {
+                // All values which aren't NULL are INTEGER
+                reals.assign(integers.begin(), integers.end());
+                integral = validity;
+                type = DataType::FLOAT;
+                return;
+            }
+
+            throw std::invalid_argument("Column batch can't store values of different data types");
+        }
+
+        /**
+         * @brief Clear column.
+         *
+         * Remove all values of the column, keeping its data type, whether
+         * it was given by a value, and the memory of its buffers.
+         */
+        void clear() {
+            integers.clear();
+            reals.clear();
+            offsets.assign(1, 0);
+            data.clear();
+            validity.clear();
+            integral.clear();
+        }
+    };
+
+    /**
+     * @brief Get data type of declared type.
+     *
+     * Get the data type which a column stores according to the affinity of
+     * its declared type, as defined by SQLite. A column without declared type
+     * has no data type (NULL_VALUE) until it gets a value, while a column
+     * declared as BLOB stores BLOBs, and a numeric column stores FLOAT
+     * values.
+     *
+     * @param[in] declared Declared type of the column.
+     *
+     * @return Data type of the column.
+     */
+    static ResultSet::DataType data_type(std::string_view declared) noexcept {
+        using DataType = ResultSet::DataType;
+
+        auto contains = [declared](std::string_view name) {
+            return std::search(declared.begin(), declared.end(), name.begin(), name.end(),
+                    [](char c, char upper) {
+                        return std::toupper(static_cast<unsigned char>(c)) == upper;
+                    }) != declared.end();
+        };
+
+        if (contains("INT")) {
+            return DataType::INTEGER;
+        }
+
+        if (contains("CHAR") || contains("CLOB") || contains("TEXT")) {
+            return DataType::TEXT;
+        }
+
+        if (declared.empty()) {
+            return DataType::NULL_VALUE;
+        }
+
+        if (contains("BLOB")) {
+            return DataType::BLOB;
+        }
+
+        if (contains("REAL") || contains("FLOA") || contains("DOUB")) {
+            return DataType::FLOAT;
+        }
+
+        // Numeric affinity, which stores both integers and reals
+        return DataType::FLOAT;
+    }
+
+    /**
+     * @brief Clear batch.
+     *
+     * Remove all rows of the batch, keeping its columns.
+     */
+    void clear() {
+        rows = 0;
+
+        for (auto& column : columns) {
+            column.clear();
+        }
+    }
+
+    /**
+     * @brief Number of rows of the batch.
+     */
+    size_t rows = 0;
+
+    /**
+     * @brief Source of the batch.
+     *
+     * Identifier of the result which filled the batch, or zero. When the
+     * batch is filled from another result, its columns start over.
+     */
+    uint64_t source = 0;
+
+    /**
+     * @brief Columns of the batch.
+     */
+    std::vector<Column> columns;
+};
+
+} // namespace cppdbc
+
+#endif // COLUMN_BATCH_HPP
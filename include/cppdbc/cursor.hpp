@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Cursor.
+ * @file
+ */
+
+#ifndef CURSOR_HPP
+#define CURSOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "prefetching_resultset.hpp"
+#include "result_table.hpp"
+#include "resultset.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Cursor.
+ *
+ * A cursor is a movable handle to the result set of a statement. The result
+ * set is owned by the statement, so a cursor doesn't allocate memory and it's
+ * cheap to move around. The cursor shares the ownership of the statement, so
+ * the statement isn't destroyed nor returned to the statement cache while the
+ * cursor has a row.
+ *
+ * An empty cursor has no current row. A cursor is valid until its statement
+ * is queried again or reset.
+ */
+class Cursor {
+public:
+    /**
+     * @brief Create empty cursor.
+     *
+     * Constructor of a cursor without rows.
+     */
+    Cursor() noexcept = default;
+
+    /**
+     * @brief Create cursor.
+     *
+     * Constructor of the cursor positioned on the current row of a result
+     * set.
+     *
+     * @param[in] result Result set owned by the statement, sharing the
+     * ownership of the statement.
+     */
+    explicit Cursor(std::shared_ptr<ResultSet> result) noexcept : result_{std::move(result)} {}
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Cursor is not copyable.
+     */
+    Cursor(const Cursor&) = delete;
+
+    /**
+     * @brief Move constructor.
+     *
+     * Move constructor of the cursor.
+     */
+    Cursor(Cursor&& other) noexcept = default;
+
+    /**
+     * @brief Destroy cursor.
+     *
+     * Destructor of the cursor.
+     */
+    ~Cursor() = default;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Cursor is not copyable.
+     */
+    Cursor& operator=(const Cursor&) = delete;
+
+    /**
+     * @brief Move assignment.
+     *
+     * Move assignment of the cursor.
+     */
+    Cursor& operator=(Cursor&& other) noexcept = default;
+
+    /**
+     * @brief Check if cursor has row.
+     *
+     * @retval true - cursor is positioned on a row.
+     * @retval false - cursor is empty.
+     */
+    explicit operator bool() const noexcept {
+        return result_ != nullptr;
+    }
+
+    /**
+     * @brief Next row.
+     *
+     * Move the cursor to the next row. When there are no more rows, the
+     * cursor becomes empty.
+     *
+     * @retval true - cursor moved to next row.
+     * @retval false - cursor finished.
+     * @throw std::logic_error in case of failure to move to next row.
+     */
+    bool next() {
+        if (result_ != nullptr && !result_->next()) {
+            result_ = nullptr;
+        }
+
+        return result_ != nullptr;
+    }
+
+    /**
+     * @brief Get result set.
+     *
+     * @return Result set positioned on the current row.
+     * @throw std::logic_error in case of empty cursor.
+     */
+    ResultSet& operator*() const {
+        if (result_ == nullptr) {
+            throw std::logic_error("Cannot access empty cursor");
+        }
+
+        return *result_;
+    }
+
+    /**
+     * @brief Get result set.
+     *
+     * @return Pointer to the result set positioned on the current row.
+     * @throw std::logic_error in case of empty cursor.
+     */
+    ResultSet* operator->() const {
+        return &**this;
+    }
+
+    /**
+     * @brief Fetch all rows.
+     *
+     * Read the current and the remaining rows into new values of a mapped
+     * type, appended to a vector. Afterwards, the cursor is empty.
+     *
+     * @tparam T Mapped type (see cppdbc::Mapping).
+     * @param[out] rows Vector which shall receive the rows.
+     *
+     * @return Number of fetched rows.
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of failure to read the rows.
+     */
+    template<typename T>
+    size_t fetch_all(std::vector<T>& rows) {
+        size_t count = 0;
+
+        // A row is appended only once it's read, so a failure doesn't leave
+        // a partial row in the vector
+        for (; result_ != nullptr; next()) {
+            T row{};
+            result_->fetch_as(row);
+            rows.push_back(std::move(row));
+            count++;
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Fetch all rows into arena.
+     *
+     * Copy the current and the remaining rows into a result table whose
+     * values, texts and BLOBs are all allocated from the given arena.
+     * Afterwards, the cursor is empty.
+     *
+     * @param[in] arena Memory resource which the table is allocated from.
+     *
+     * @return Table with the fetched rows.
+     * @throw std::logic_error in case of failure to read the rows.
+     */
+    ResultTable fetch_all(std::pmr::memory_resource& arena) {
+        ResultTable table(arena, result_ != nullptr ? result_->metadata()->column_count() : 0);
+
+        for (; result_ != nullptr; next()) {
+            table.append(*result_);
+        }
+
+        return table;
+    }
+
+private:
+    /**
+     * @brief Result set owned by the statement.
+     *
+     * @note It shares the ownership of the statement.
+     */
+    std::shared_ptr<ResultSet> result_;
+};
+
+/**
+ * @brief Rows.
+ *
+ * Input range over the rows of a cursor, which can be used by range-based
+ * for loops and standard algorithms. Each row is the result set positioned
+ * on it, and the range can be iterated only once. As its cursor, the range
+ * shares the ownership of the statement.
+ */
+class Rows {
+public:
+    /**
+     * @brief Row iterator.
+     *
+     * Input iterator over the rows of the range. The end iterator has no
+     * cursor.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ResultSet;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ResultSet*;
+        using reference = ResultSet&;
+
+        /**
+         * @brief Create end iterator.
+         */
+        iterator() noexcept = default;
+
+        /**
+         * @brief Create iterator.
+         *
+         * Constructor of the iterator positioned on the current row of a
+         * cursor.
+         *
+         * @param[in] cursor Cursor of the range.
+         */
+        explicit iterator(Cursor* cursor) noexcept : cursor_{*cursor ? cursor : nullptr} {}
+
+        /**
+         * @brief Get row.
+         *
+         * @return Result set positioned on the row.
+         */
+        reference operator*() const {
+            return **cursor_;
+        }
+
+        /**
+         * @brief Get row.
+         *
+         * @return Pointer to the result set positioned on the row.
+         */
+        pointer operator->() const {
+            return &**cursor_;
+        }
+
+        /**
+         * @brief Move to next row.
+         *
+         * @throw std::logic_error in case of failure to move to next row.
+         */
+        iterator& operator++() {
+            if (!cursor_->next()) {
+                cursor_ = nullptr;
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Move to next row.
+         *
+         * @throw std::logic_error in case of failure to move to next row.
+         */
+        iterator operator++(int) {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        /**
+         * @brief Compare iterators.
+         */
+        bool operator==(const iterator& other) const noexcept {
+            return cursor_ == other.cursor_;
+        }
+
+        /**
+         * @brief Compare iterators.
+         */
+        bool operator!=(const iterator& other) const noexcept {
+            return cursor_ != other.cursor_;
+        }
+
+    private:
+        /**
+         * @brief Cursor of the range.
+         */
+        Cursor* cursor_ = nullptr;
+    };
+
+    /**
+     * @brief Create rows.
+     *
+     * Constructor of the range over the rows of a cursor, starting from its
+     * current row.
+     *
+     * @param[in] cursor Cursor of the range.
+     */
+    explicit Rows(Cursor cursor) noexcept : cursor_{std::move(cursor)} {}
+
+    /**
+     * @brief Create prefetching rows.
+     *
+     * Constructor of the range over the rows of a cursor, starting from its
+     * current row, which are prefetched in background by a
+     * PrefetchingResultSet. While a batch of rows is consumed, the next one
+     * is fetched, so the work done on each row overlaps with stepping the
+     * statement. The range owns the cursor, which must not be used
+     * elsewhere.
+     *
+     * @param[in] cursor Cursor of the range.
+     * @param[in] prefetch Number of rows of each prefetched batch.
+     *
+     * @throw std::invalid_argument in case of invalid number of rows.
+     * @throw std::logic_error in case of failure to fetch the first batch.
+     */
+    Rows(Cursor cursor, size_t prefetch) : cursor_{prefetched(std::move(cursor), prefetch)} {}
+
+    /**
+     * @brief Get iterator to the current row.
+     */
+    iterator begin() noexcept {
+        return iterator(&cursor_);
+    }
+
+    /**
+     * @brief Get end iterator.
+     */
+    iterator end() noexcept {
+        return iterator();
+    }
+
+private:
+    /**
+     * @brief Prefetched rows.
+     *
+     * Prefetching result set along with the cursor of its source, which is
+     * destroyed after the prefetching has stopped.
+     */
+    struct Prefetched {
+        Prefetched(Cursor cursor, size_t rows) : source{std::move(cursor)}, result{*source, rows} {}
+
+        Cursor source;
+        PrefetchingResultSet result;
+    };
+
+    /**
+     * @brief Prefetch rows of cursor.
+     *
+     * @param[in] cursor Cursor whose rows shall be prefetched.
+     * @param[in] rows Number of rows of each prefetched batch.
+     *
+     * @return Cursor over the prefetched rows, which owns the given cursor.
+     * @throw std::invalid_argument in case of invalid number of rows.
+     * @throw std::logic_error in case of failure to fetch the first batch.
+     */
+    static Cursor prefetched(Cursor cursor, size_t rows) {
+        if (rows == 0) {
+            throw std::invalid_argument("Invalid number of rows per batch");
+        }
+
+        if (!cursor) {
+            return cursor;
+        }
+
+        auto prefetched = std::make_shared<Prefetched>(std::move(cursor), rows);
+        return Cursor(std::shared_ptr<ResultSet>(prefetched, &prefetched->result));
+    }
+
+    /**
+     * @brief Cursor of the range.
+     */
+    Cursor cursor_;
+};
+
+} // namespace cppdbc
+
+#endif // CURSOR_HPP
@@ -29,6 +29,7 @@
 #define DATABASE_HPP
 
 #include <memory>
+#include <string_view>
 
 #include "exception.hpp"
 #include "resultset.hpp"
@@ -86,6 +87,19 @@ public:
      */
     virtual std::shared_ptr<Transaction> create_transaction() = 0;
 
+    /**
+     * @brief Execute script.
+     *
+     * Execute all SQL statements of the script in order. The execution stops
+     * at the first statement which fails.
+     *
+     * @param[in] script SQL statements to be executed.
+     *
+     * @throw cppdbc::script_error in case of failure to execute a statement.
+     * @throw std::logic_error in case of invalid database.
+     */
+    virtual void execute_script(std::string_view script) = 0;
+
     /**
      * @brief Check if table exists.
      *
@@ -28,7 +28,9 @@
 #ifndef EXCEPTION_HPP
 #define EXCEPTION_HPP
 
+#include <cstddef>
 #include <stdexcept>
+#include <string>
 
 namespace cppdbc {
 
@@ -47,6 +49,60 @@ public:
     constraint_violation() : std::logic_error("Constraint violation") {};
 };
 
+/**
+ * @brief Script error.
+ *
+ * This exception is thrown when a statement of a script fails to be prepared
+ * or executed. The statements before the failing one have been executed.
+ */
+class script_error : public std::logic_error {
+public:
+    /**
+     * @brief Create exception.
+     *
+     * Constructor of the exception.
+     *
+     * @param[in] statement Index of the failing statement in the script.
+     * @param[in] offset Offset, in bytes, of the failing statement in the
+     * script.
+     * @param[in] message Error message reported by the database.
+     */
+    script_error(size_t statement, size_t offset, const std::string& message) :
+            std::logic_error("Failed to execute statement " + std::to_string(statement) +
+                    " at offset " + std::to_string(offset) + ": " + message),
+            statement_{statement},
+            offset_{offset} {};
+
+    /**
+     * @brief Get statement.
+     *
+     * @return Index of the failing statement in the script.
+     */
+    [[nodiscard]] size_t statement() const noexcept {
+        return statement_;
+    }
+
+    /**
+     * @brief Get offset.
+     *
+     * @return Offset, in bytes, of the failing statement in the script.
+     */
+    [[nodiscard]] size_t offset() const noexcept {
+        return offset_;
+    }
+
+private:
+    /**
+     * @brief Index of the failing statement.
+     */
+    size_t statement_;
+
+    /**
+     * @brief Offset of the failing statement.
+     */
+    size_t offset_;
+};
+
 } // namespace cppdbc
 
 #endif //EXCEPTION_HPP
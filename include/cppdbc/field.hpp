@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Result set field.
+ * @file
+ */
+
+#ifndef FIELD_HPP
+#define FIELD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cppdbc {
+
+/**
+ * @brief Result set field.
+ *
+ * A field is a reference to a variable which shall receive the value of a
+ * column of a result set. The type of the field is resolved at compile time
+ * from the type of the variable, so many columns can be read at once without
+ * dispatching each value.
+ *
+ * A field of a std::optional variable is nullable: a NULL value resets the
+ * variable to std::nullopt, while any other value is read as the value type
+ * of the optional.
+ *
+ * @note A field doesn't own its variable, which must outlive the field.
+ */
+class Field {
+public:
+    /**
+     * @brief Field type.
+     *
+     * Type of the variable of the field.
+     */
+    enum class Type {
+        BOOL,       /*!< bool */
+        INT8,       /*!< int8_t */
+        INT16,      /*!< int16_t */
+        INT32,      /*!< int32_t */
+        INT64,      /*!< int64_t */
+        UINT8,      /*!< uint8_t */
+        UINT16,     /*!< uint16_t */
+        UINT32,     /*!< uint32_t */
+        UINT64,     /*!< uint64_t */
+        FLOAT,      /*!< float */
+        DOUBLE,     /*!< double */
+        TEXT,       /*!< std::string */
+        BLOB        /*!< std::vector<std::byte> */
+    };
+
+    /**
+     * @brief Create field.
+     *
+     * Constructor of the field from a pointer to a variable of any supported
+     * type.
+     *
+     * @param[in] target Variable which shall receive the value.
+     */
+    template<typename T>
+    explicit Field(T* target) noexcept : type_{type_of<T>()}, target_{target} {}
+
+    /**
+     * @brief Create nullable field.
+     *
+     * Constructor of the field from a pointer to an optional variable of any
+     * supported type.
+     *
+     * @param[in] target Optional variable which shall receive the value.
+     */
+    template<typename T>
+    explicit Field(std::optional<T>* target) noexcept :
+            type_{type_of<T>()},
+            target_{target},
+            reset_{[](void* optional) noexcept { static_cast<std::optional<T>*>(optional)->reset(); }} {}
+
+    /**
+     * @brief Get type.
+     *
+     * @return Type of the field.
+     */
+    [[nodiscard]] Type type() const noexcept {
+        return type_;
+    }
+
+    /**
+     * @brief Check if field is nullable.
+     *
+     * @retval true - field receives NULL values.
+     * @retval false - field doesn't receive NULL values.
+     */
+    [[nodiscard]] bool nullable() const noexcept {
+        return reset_ != nullptr;
+    }
+
+    /**
+     * @brief Set NULL value.
+     *
+     * Reset the optional variable of a nullable field to std::nullopt.
+     */
+    void set_null() const noexcept {
+        reset_(target_);
+    }
+
+    /**
+     * @brief Get variable.
+     *
+     * The optional variable of a nullable field gets a value before it's
+     * returned.
+     *
+     * @tparam T Type of the variable, which must match the type of the field.
+     *
+     * @return Variable which shall receive the value.
+     */
+    template<typename T>
+    [[nodiscard]] T& get() const noexcept {
+        if (reset_ != nullptr) {
+            return static_cast<std::optional<T>*>(target_)->emplace();
+        }
+
+        return *static_cast<T*>(target_);
+    }
+
+private:
+    /**
+     * @brief Get type of variable.
+     *
+     * @return Type of the field for the type of the variable.
+     */
+    template<typename T>
+    static constexpr Type type_of() noexcept {
+        if constexpr (std::is_same_v<T, bool>) {
+            return Type::BOOL;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            if constexpr (sizeof(T) == sizeof(int8_t)) {
+                return Type::INT8;
+            } else if constexpr (sizeof(T) == sizeof(int16_t)) {
+                return Type::INT16;
+            } else if constexpr (sizeof(T) == sizeof(int32_t)) {
+                return Type::INT32;
+            } else {
+                return Type::INT64;
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (sizeof(T) == sizeof(uint8_t)) {
+                return Type::UINT8;
+            } else if constexpr (sizeof(T) == sizeof(uint16_t)) {
+                return Type::UINT16;
+            } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+                return Type::UINT32;
+            } else {
+                return Type::UINT64;
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Type::FLOAT;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return Type::DOUBLE;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return Type::TEXT;
+        } else {
+            static_assert(std::is_same_v<T, std::vector<std::byte>>, "Unsupported field type");
+            return Type::BLOB;
+        }
+    }
+
+    /**
+     * @brief Type of the field.
+     */
+    Type type_;
+
+    /**
+     * @brief Variable which shall receive the value.
+     */
+    void* target_;
+
+    /**
+     * @brief Function to reset the optional variable of a nullable field.
+     */
+    void (*reset_)(void*) noexcept = nullptr;
+};
+
+} // namespace cppdbc
+
+#endif // FIELD_HPP
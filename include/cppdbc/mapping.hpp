@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Row mapping.
+ * @file
+ */
+
+#ifndef MAPPING_HPP
+#define MAPPING_HPP
+
+#include <array>
+#include <tuple>
+
+#include "field.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Row mapping.
+ *
+ * A mapping lists the members of a type which are mapped to the columns of
+ * a row, or to the parameters of a statement, in order. A type is mapped by
+ * specializing this template with a static @c fields tuple of pointers to
+ * members, usually through the CPPDBC_MAPPING macro. A member of a
+ * std::optional type maps a NULL column to std::nullopt.
+ *
+ * @tparam T Mapped type.
+ */
+template<typename T>
+struct Mapping;
+
+/**
+ * @brief Create fields.
+ *
+ * Create the fields which refer to the mapped members of a value.
+ *
+ * @param[in] value Value which shall receive the columns.
+ *
+ * @return Fields of the mapped members, in order.
+ */
+template<typename T>
+auto mapped_fields(T& value) noexcept {
+    return std::apply([&value](auto... members) {
+        return std::array<Field, sizeof...(members)>{Field(&(value.*members))...};
+    }, Mapping<T>::fields);
+}
+
+} // namespace cppdbc
+
+/**
+ * @brief Map type.
+ *
+ * Specialize cppdbc::Mapping for a type, given pointers to its mapped
+ * members in the order of the columns. It must be used in the global
+ * namespace.
+ *
+ * @code
+ * CPPDBC_MAPPING(User, &User::id, &User::name);
+ * @endcode
+ */
+#define CPPDBC_MAPPING(Type, ...)                                               \
+    template<>                                                                  \
+    struct cppdbc::Mapping<Type> {                                              \
+        static constexpr auto fields = std::make_tuple(__VA_ARGS__);            \
+    }
+
+#endif // MAPPING_HPP
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Statement parameter.
+ * @file
+ */
+
+#ifndef PARAMETER_HPP
+#define PARAMETER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cppdbc {
+
+/**
+ * @brief Statement parameter.
+ *
+ * A parameter is a view of a value to be bound to a statement. The type of
+ * the parameter is resolved at compile time from the type of the value, so
+ * many parameters can be bound at once without dispatching each value.
+ *
+ * @note A parameter doesn't own its value. Text and BLOB values are bound
+ * without being copied, so they must outlive the execution of the statement
+ * (until it's reset, its bindings are cleared or the parameter is bound
+ * again).
+ */
+class Parameter {
+public:
+    /**
+     * @brief Parameter type.
+     *
+     * Type of the value of the parameter.
+     */
+    enum class Type {
+        INTEGER,    /*!< Integer (signed or unsigned) */
+        FLOAT,      /*!< Float (float or double) */
+        TEXT,       /*!< Text (string) */
+        BLOB,       /*!< BLOB (memory) */
+        NULL_VALUE  /*!< NULL */
+    };
+
+    /**
+     * @brief Create NULL parameter.
+     *
+     * Constructor of the parameter without value.
+     */
+    constexpr Parameter(std::nullopt_t) noexcept : // NOLINT(google-explicit-constructor)
+            type_{Type::NULL_VALUE},
+            integer_{0} {}
+
+    /**
+     * @brief Create optional parameter.
+     *
+     * Constructor of the parameter from an optional value, which is NULL
+     * when the optional is empty.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    template<typename T>
+    Parameter(const std::optional<T>& value) noexcept : // NOLINT(google-explicit-constructor)
+            Parameter(value ? Parameter(*value) : Parameter(std::nullopt)) {}
+
+    /**
+     * @brief Create integer parameter.
+     *
+     * Constructor of the parameter from any integer type.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    constexpr Parameter(T value) noexcept : // NOLINT(google-explicit-constructor)
+            type_{Type::INTEGER},
+            integer_{static_cast<int64_t>(value)} {}
+
+    /**
+     * @brief Create float parameter.
+     *
+     * Constructor of the parameter from any floating point type.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    constexpr Parameter(T value) noexcept : // NOLINT(google-explicit-constructor)
+            type_{Type::FLOAT},
+            real_{static_cast<double>(value)} {}
+
+    /**
+     * @brief Create text parameter.
+     *
+     * Constructor of the parameter from a string view.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    constexpr Parameter(std::string_view value) noexcept : // NOLINT(google-explicit-constructor)
+            type_{Type::TEXT},
+            memory_{value.data(), value.size()} {}
+
+    /**
+     * @brief Create text parameter.
+     *
+     * Constructor of the parameter from a string.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    Parameter(const std::string& value) noexcept : // NOLINT(google-explicit-constructor)
+            Parameter(std::string_view(value)) {}
+
+    /**
+     * @brief Create text parameter.
+     *
+     * Constructor of the parameter from a null-terminated string.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    constexpr Parameter(const char* value) noexcept : // NOLINT(google-explicit-constructor)
+            Parameter(std::string_view(value)) {}
+
+    /**
+     * @brief Create BLOB parameter.
+     *
+     * Constructor of the parameter from a vector of bytes.
+     *
+     * @param[in] value Value of the parameter.
+     */
+    Parameter(const std::vector<std::byte>& value) noexcept : // NOLINT(google-explicit-constructor)
+            type_{Type::BLOB},
+            memory_{value.data(), value.size()} {}
+
+    /**
+     * @brief Get type.
+     *
+     * @return Type of the parameter.
+     */
+    [[nodiscard]] constexpr Type type() const noexcept {
+        return type_;
+    }
+
+    /**
+     * @brief Get integer.
+     *
+     * @return Value of the integer parameter.
+     */
+    [[nodiscard]] constexpr int64_t integer() const noexcept {
+        return integer_;
+    }
+
+    /**
+     * @brief Get float.
+     *
+     * @return Value of the float parameter.
+     */
+    [[nodiscard]] constexpr double real() const noexcept {
+        return real_;
+    }
+
+    /**
+     * @brief Get data.
+     *
+     * @return Pointer to the memory of the text or BLOB parameter.
+     */
+    [[nodiscard]] constexpr const void* data() const noexcept {
+        return memory_.data;
+    }
+
+    /**
+     * @brief Get size.
+     *
+     * @return Number of bytes of the text or BLOB parameter.
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return memory_.size;
+    }
+
+private:
+    /**
+     * @brief Memory of text or BLOB values.
+     */
+    struct Memory {
+        const void* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Type of the parameter.
+     */
+    Type type_;
+
+    /**
+     * @brief Value of the parameter.
+     */
+    union {
+        int64_t integer_;
+        double real_;
+        Memory memory_;
+    };
+};
+
+} // namespace cppdbc
+
+#endif // PARAMETER_HPP
@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Prefetching result set.
+ * @file
+ */
+
+#ifndef PREFETCHING_RESULT_SET_HPP
+#define PREFETCHING_RESULT_SET_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "column_batch.hpp"
+#include "resultset.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Prefetching result set.
+ *
+ * A prefetching result set fetches the rows of another result set on a
+ * background thread, in batches, while the current rows are consumed. The
+ * batches are passed through a bounded single-producer single-consumer ring,
+ * so the time spent stepping the statement (e.g. reading from disk) overlaps
+ * with the time spent processing the rows.
+ *
+ * The rows are stored in column batches (see ResultSet::fetch_batch), which
+ * keep the INTEGER values of FLOAT columns without loss, so each value has
+ * the same data type and value as in the source result set.
+ *
+ * @note The source result set, its statement and its database must not be
+ * used while the prefetching result set exists.
+ */
+class PrefetchingResultSet : public ResultSet {
+public:
+    /**
+     * @brief Default number of rows of each batch.
+     */
+    static constexpr size_t DEFAULT_BATCH_ROWS = 1024;
+
+    /**
+     * @brief Default number of batches of the ring.
+     */
+    static constexpr size_t DEFAULT_DEPTH = 2;
+
+    /**
+     * @brief Create prefetching result set.
+     *
+     * Constructor of the prefetching result set, which starts fetching the
+     * rows in background and waits for the first batch.
+     *
+     * @param[in] source Result set positioned on its first row to be fetched.
+     * @param[in] rows Number of rows of each batch.
+     * @param[in] depth Number of batches of the ring, including the batch
+     * being consumed (2 for double buffering).
+     *
+     * @throw std::invalid_argument in case of invalid number of rows or depth.
+     * @throw std::logic_error in case of failure to fetch the first batch.
+     */
+    explicit PrefetchingResultSet(ResultSet& source, size_t rows = DEFAULT_BATCH_ROWS,
+            size_t depth = DEFAULT_DEPTH);
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Prefetching result set is not copyable.
+     */
+    PrefetchingResultSet(const PrefetchingResultSet&) = delete;
+
+    /**
+     * @brief Destroy prefetching result set.
+     *
+     * Destructor of the prefetching result set, which stops the background
+     * thread after its current batch.
+     */
+    ~PrefetchingResultSet() override;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Prefetching result set is not copyable.
+     */
+    PrefetchingResultSet& operator=(const PrefetchingResultSet&) = delete;
+
+    /**
+     * @brief Check if result set has row.
+     *
+     * @retval true - result set is positioned on a row.
+     * @retval false - result set finished.
+     */
+    [[nodiscard]] bool pending() const noexcept;
+
+    /**
+     * @brief Next result set.
+     *
+     * Move result set to the next row, waiting for the next batch when the
+     * current one has been consumed.
+     *
+     * @retval true - result set moved to next result.
+     * @retval false - result set finished.
+     * @throw std::logic_error in case of failure to fetch the rows in
+     * background (the exception of the source result set is rethrown).
+     */
+    bool next() override;
+
+    /**
+     * @brief Set type checking.
+     *
+     * Enable or disable checking the data type of a column before getting
+     * its value. When it's disabled, integers and floats are converted to
+     * each other, and NULL values are read as zero or empty.
+     *
+     * @param[in] enabled Indicates if the data types shall be checked.
+     */
+    void set_type_checking(bool enabled) noexcept override;
+
+    /**
+     * @brief Get data type.
+     *
+     * @param[in] column Column to get the data type.
+     *
+     * @return Data type of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    DataType data_type(column_t column) const override;
+
+    /**
+     * @brief Check if value is NULL.
+     *
+     * @param[in] column Column to check.
+     *
+     * @retval true - value is NULL.
+     * @retval false - value is not NULL.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    bool is_null(column_t column) const override;
+
+    /**
+     * @brief Get unsigned integer (8-bits).
+     *
+     * Get unsigned integer (8-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    uint8_t uint8(column_t column) const override;
+
+    /**
+     * @brief Get unsigned integer (16-bits).
+     *
+     * Get unsigned integer (16-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    uint16_t uint16(column_t column) const override;
+
+    /**
+     * @brief Get unsigned integer (32-bits).
+     *
+     * Get unsigned integer (32-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    uint32_t uint32(column_t column) const override;
+
+    /**
+     * @brief Get unsigned integer (64-bits).
+     *
+     * Get unsigned integer (64-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    uint64_t uint64(column_t column) const override;
+
+    /**
+     * @brief Get signed integer (8-bits).
+     *
+     * Get signed integer (8-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    int8_t int8(column_t column) const override;
+
+    /**
+     * @brief Get signed integer (16-bits).
+     *
+     * Get signed integer (16-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    int16_t int16(column_t column) const override;
+
+    /**
+     * @brief Get signed integer (32-bits).
+     *
+     * Get signed integer (32-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    int32_t int32(column_t column) const override;
+
+    /**
+     * @brief Get signed integer (64-bits).
+     *
+     * Get signed integer (64-bits) value from a given column of the result
+     * set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    int64_t int64(column_t column) const override;
+
+    /**
+     * @brief Get boolean.
+     *
+     * Get boolean value from a given column of the result set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    bool boolean(column_t column) const override;
+
+    /**
+     * @brief Get float.
+     *
+     * Get float value from a given column of the result set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    float flt(column_t column) const override;
+
+    /**
+     * @brief Get double.
+     *
+     * Get double value from a given column of the result set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    double dbl(column_t column) const override;
+
+    /**
+     * @brief Get string.
+     *
+     * Get string value from a given column of the result set.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return String got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get string.
+     */
+    std::string str(column_t column) const override;
+
+    /**
+     * @brief Get BLOB.
+     *
+     * Get BLOB value from a given column of the result set.
+     *
+     * @param[in] column Column to get value.
+     * @param[out] size Pointer to store the number of bytes read.
+     *
+     * @retval Pointer to memory got from column.
+     * @retval nullptr when there's no data in the column.
+     * @throw std::invalid_argument in case of invalid column or size's pointer.
+     * @throw std::logic_error in case of failure to get BLOB.
+     */
+    std::unique_ptr<const void*> blob(column_t column, size_t* size) const override;
+
+    /**
+     * @brief Get text view.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the text, valid until the result set moves to the
+     * next batch.
+     * @throw std::invalid_argument in case of invalid column or data type.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    std::string_view text_view(column_t column) const override;
+
+    /**
+     * @brief Get BLOB view.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the BLOB, valid until the result set moves to the next
+     * batch.
+     * @throw std::invalid_argument in case of invalid column or data type.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    BlobView blob_view(column_t column) const override;
+
+    /**
+     * @brief Fetch batch.
+     *
+     * Copy up to a given number of rows, starting from the current one, into
+     * a batch (see ResultSet::fetch_batch).
+     *
+     * @param[out] batch Batch to store the rows.
+     * @param[in] rows Maximum number of rows to fetch.
+     *
+     * @return Number of fetched rows, zero when the result set finished.
+     * @throw std::invalid_argument in case of the values of a column can't be
+     * stored in the batch without loss.
+     * @throw std::logic_error in case of failure to fetch the rows.
+     */
+    size_t fetch_batch(ColumnBatch& batch, size_t rows) override;
+
+    /**
+     * @brief Read fields.
+     *
+     * @param[out] fields Fields which shall receive the columns.
+     * @param[in] count Number of fields.
+     *
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    void read(const Field* fields, size_t count) const override;
+
+    /**
+     * @brief Get metadata.
+     *
+     * @return Metadata of the source result set.
+     */
+    [[nodiscard]] std::shared_ptr<const ResultSetMetadata> metadata() const override;
+
+private:
+    /**
+     * @brief Produce batches.
+     *
+     * Fetch the batches of the source result set until it finishes or the
+     * result set is destroyed. It runs on the background thread.
+     */
+    void produce();
+
+    /**
+     * @brief Move to next batch.
+     *
+     * Release the current batch, if any, and wait for the next one.
+     *
+     * @retval true - result set moved to the first row of the next batch.
+     * @retval false - result set finished.
+     * @throw std::logic_error in case of failure to fetch the rows in
+     * background.
+     */
+    bool next_batch();
+
+    /**
+     * @brief Get column of current row.
+     *
+     * @param[in] column Index of the column.
+     * @param[in] type Expected data type.
+     *
+     * @return Column of the current batch, or null pointer when the value is
+     * NULL and can be read as zero or empty.
+     * @throw std::invalid_argument in case of invalid column or data type.
+     * @throw std::logic_error in case of the result set has no row.
+     */
+    const ColumnBatch::Column* column(column_t column, DataType type) const;
+
+    /**
+     * @brief Get integer value.
+     *
+     * @param[in] column Index of the column.
+     *
+     * @return Value of the column, converted when type checking is disabled.
+     */
+    int64_t integer(column_t column) const;
+
+    /**
+     * @brief Get float value.
+     *
+     * @param[in] column Index of the column.
+     *
+     * @return Value of the column, converted when type checking is disabled.
+     */
+    double real(column_t column) const;
+
+    /**
+     * @brief Source result set.
+     */
+    ResultSet& source_;
+
+    /**
+     * @brief Metadata of the source result set.
+     */
+    std::shared_ptr<const ResultSetMetadata> metadata_;
+
+    /**
+     * @brief Number of rows of each batch.
+     */
+    size_t rows_;
+
+    /**
+     * @brief Ring of batches.
+     */
+    std::vector<ColumnBatch> ring_;
+
+    /**
+     * @brief Number of batches produced.
+     */
+    std::atomic<size_t> head_{0};
+
+    /**
+     * @brief Number of batches consumed.
+     */
+    std::atomic<size_t> tail_{0};
+
+    /**
+     * @brief Indicates if the producer finished.
+     */
+    std::atomic<bool> done_{false};
+
+    /**
+     * @brief Indicates if the producer shall stop.
+     */
+    std::atomic<bool> stop_{false};
+
+    /**
+     * @brief Exception thrown by the producer.
+     */
+    std::exception_ptr error_;
+
+    /**
+     * @brief Mutex to wait for the ring.
+     *
+     * @note It's only used to sleep while the ring is empty or full.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Condition to wait for the ring.
+     */
+    std::condition_variable condition_;
+
+    /**
+     * @brief Current batch, or null pointer when finished.
+     */
+    const ColumnBatch* batch_ = nullptr;
+
+    /**
+     * @brief Current row of the current batch.
+     */
+    size_t row_ = 0;
+
+    /**
+     * @brief Indicates if the data types are checked.
+     */
+    bool type_checking_ = true;
+
+    /**
+     * @brief Background thread.
+     */
+    std::thread producer_;
+};
+
+} // namespace cppdbc
+
+#endif // PREFETCHING_RESULT_SET_HPP
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Result table.
+ * @file
+ */
+
+#ifndef RESULT_TABLE_HPP
+#define RESULT_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+
+#include "resultset.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Result table.
+ *
+ * A result table stores the rows of a result set in memory, with all its
+ * values, texts and BLOBs allocated from a single memory resource (arena),
+ * such as a std::pmr::monotonic_buffer_resource. The whole table is released
+ * at once by releasing its arena.
+ *
+ * @note The texts and BLOBs of the table are views into the arena, so the
+ * table and its values must not outlive the arena.
+ */
+class ResultTable {
+public:
+    /**
+     * @brief Value of the table.
+     *
+     * A NULL value is stored as std::monostate.
+     */
+    using Value = std::variant<std::monostate, int64_t, double, std::string_view, BlobView>;
+
+    /**
+     * @brief Create result table.
+     *
+     * Constructor of an empty result table.
+     *
+     * @param[in] arena Memory resource which all memory is allocated from.
+     * @param[in] columns Number of columns of each row.
+     */
+    ResultTable(std::pmr::memory_resource& arena, size_t columns) :
+            arena_{&arena},
+            columns_{columns},
+            values_{&arena} {}
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Result table is not copyable, as a copy of its values wouldn't be
+     * allocated from its arena.
+     */
+    ResultTable(const ResultTable&) = delete;
+
+    /**
+     * @brief Move constructor.
+     *
+     * Move constructor of the result table, which keeps its arena.
+     */
+    ResultTable(ResultTable&& other) = default;
+
+    /**
+     * @brief Destroy result table.
+     *
+     * Destructor of the result table.
+     */
+    ~ResultTable() = default;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Result table is not copyable.
+     */
+    ResultTable& operator=(const ResultTable&) = delete;
+
+    /**
+     * @brief Remove move assignment.
+     *
+     * Result table is not move assignable, as the moved values would be
+     * allocated from the arena of the assigned table.
+     */
+    ResultTable& operator=(ResultTable&&) = delete;
+
+    /**
+     * @brief Get number of rows.
+     *
+     * @return Number of rows of the table.
+     */
+    [[nodiscard]] size_t rows() const noexcept {
+        return columns_ == 0 ? 0 : values_.size() / columns_;
+    }
+
+    /**
+     * @brief Get number of columns.
+     *
+     * @return Number of columns of each row.
+     */
+    [[nodiscard]] size_t columns() const noexcept {
+        return columns_;
+    }
+
+    /**
+     * @brief Get value.
+     *
+     * @param[in] row Index of the row.
+     * @param[in] column Index of the column.
+     *
+     * @return Value of the column of the row.
+     * @throw std::invalid_argument in case of invalid row or column.
+     */
+    [[nodiscard]] const Value& at(size_t row, column_t column) const {
+        if (row >= rows() || column >= columns_) {
+            throw std::invalid_argument("Invalid row or column");
+        }
+
+        return values_[row * columns_ + column];
+    }
+
+    /**
+     * @brief Get arena.
+     *
+     * @return Memory resource which all memory is allocated from.
+     */
+    [[nodiscard]] std::pmr::memory_resource& arena() const noexcept {
+        return *arena_;
+    }
+
+    /**
+     * @brief Append row.
+     *
+     * Copy the current row of a result set to the end of the table. In case
+     * of failure, no value of the row is kept in the table.
+     *
+     * @param[in] result Result set positioned on the row.
+     *
+     * @throw std::bad_alloc in case of failure to allocate from the arena.
+     * @throw std::logic_error in case of failure to read the row.
+     */
+    void append(const ResultSet& result) {
+        size_t size = values_.size();
+
+        try {
+            append_values(result);
+        } catch (...) {
+            values_.resize(size);
+            throw;
+        }
+    }
+
+private:
+    /**
+     * @brief Append values of row.
+     *
+     * @param[in] result Result set positioned on the row.
+     *
+     * @throw std::bad_alloc in case of failure to allocate from the arena.
+     * @throw std::logic_error in case of failure to read the row.
+     */
+    void append_values(const ResultSet& result) {
+        for (size_t i = 0; i < columns_; i++) {
+            auto column = static_cast<column_t>(i);
+
+            switch (result.data_type(column)) {
+                case ResultSet::DataType::INTEGER:
+                    values_.emplace_back(result.int64(column));
+                    break;
+
+                case ResultSet::DataType::FLOAT:
+                    values_.emplace_back(result.dbl(column));
+                    break;
+
+                case ResultSet::DataType::TEXT: {
+                    std::string_view text = result.text_view(column);
+                    auto data = static_cast<const char*>(copy(text.data(), text.size()));
+                    values_.emplace_back(std::string_view(data, text.size()));
+                    break;
+                }
+
+                case ResultSet::DataType::BLOB: {
+                    BlobView blob = result.blob_view(column);
+                    auto data = static_cast<const std::byte*>(copy(blob.data(), blob.size()));
+                    values_.emplace_back(BlobView(data, blob.size()));
+                    break;
+                }
+
+                case ResultSet::DataType::NULL_VALUE:
+                    values_.emplace_back();
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Copy memory to arena.
+     *
+     * @param[in] data Pointer to the memory.
+     * @param[in] size Number of bytes to copy.
+     *
+     * @return Pointer to the copy, or null pointer when there are no bytes.
+     */
+    const void* copy(const void* data, size_t size) {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        void* memory = arena_->allocate(size, 1);
+        std::memcpy(memory, data, size);
+
+        return memory;
+    }
+
+    /**
+     * @brief Memory resource which all memory is allocated from.
+     */
+    std::pmr::memory_resource* arena_;
+
+    /**
+     * @brief Number of columns of each row.
+     */
+    size_t columns_;
+
+    /**
+     * @brief Values of the rows, in row-major order.
+     *
+     * @note A deque grows in blocks without moving its values, so no memory
+     * is wasted in arenas which never reuse released memory.
+     */
+    std::pmr::deque<Value> values_;
+};
+
+} // namespace cppdbc
+
+#endif // RESULT_TABLE_HPP
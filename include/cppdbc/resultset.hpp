@@ -28,8 +28,17 @@
 #ifndef RESULT_SET_HPP
 #define RESULT_SET_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <optional>
+#include <type_traits>
+
+#include "field.hpp"
+#include "mapping.hpp"
+#include "resultset_metadata.hpp"
 
 namespace cppdbc {
 
@@ -40,6 +49,98 @@ namespace cppdbc {
  */
 typedef uint16_t column_t;
 
+// Forward declarations
+struct ColumnBatch;
+
+/**
+ * @brief BLOB view.
+ *
+ * Non-owning view of the bytes of a BLOB.
+ */
+class BlobView {
+public:
+    /**
+     * @brief Create empty BLOB view.
+     *
+     * Constructor of a BLOB view without bytes.
+     */
+    constexpr BlobView() noexcept = default;
+
+    /**
+     * @brief Create BLOB view.
+     *
+     * Constructor of the BLOB view.
+     *
+     * @param[in] data Pointer to the first byte of the BLOB.
+     * @param[in] size Number of bytes of the BLOB.
+     */
+    constexpr BlobView(const std::byte* data, size_t size) noexcept : data_{data}, size_{size} {}
+
+    /**
+     * @brief Get data.
+     *
+     * @return Pointer to the first byte of the BLOB.
+     */
+    [[nodiscard]] constexpr const std::byte* data() const noexcept {
+        return data_;
+    }
+
+    /**
+     * @brief Get size.
+     *
+     * @return Number of bytes of the BLOB.
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * @brief Check if BLOB is empty.
+     *
+     * @retval true - BLOB has no bytes.
+     * @retval false - BLOB has bytes.
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get byte.
+     *
+     * @param[in] index Index of the byte.
+     *
+     * @return Byte at the given index.
+     */
+    constexpr const std::byte& operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+    /**
+     * @brief Get iterator to the first byte.
+     */
+    [[nodiscard]] constexpr const std::byte* begin() const noexcept {
+        return data_;
+    }
+
+    /**
+     * @brief Get iterator past the last byte.
+     */
+    [[nodiscard]] constexpr const std::byte* end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    /**
+     * @brief Pointer to the first byte.
+     */
+    const std::byte* data_ = nullptr;
+
+    /**
+     * @brief Number of bytes.
+     */
+    size_t size_ = 0;
+};
+
 /**
  * @brief SQL result set.
  *
@@ -56,7 +157,8 @@ public:
         INTEGER,    /*!< Integer (signed or unsigned) */
         FLOAT,      /*!< Float (float or double) */
         TEXT,       /*!< Text (string) */
-        BLOB        /*!< BLOB (memory) */
+        BLOB,       /*!< BLOB (memory) */
+        NULL_VALUE  /*!< NULL */
     };
 
     /**
@@ -77,6 +179,18 @@ public:
      */
     virtual bool next() = 0;
 
+    /**
+     * @brief Set type checking.
+     *
+     * Enable or disable checking the data type of a column before getting
+     * its value. Type checking is enabled by default. When it's disabled,
+     * the value is converted by the database to the requested type, which
+     * is only safe when the schema of the result is trusted.
+     *
+     * @param[in] enabled Indicates if the data types shall be checked.
+     */
+    virtual void set_type_checking(bool enabled) noexcept = 0;
+
     /**
      * @brief Get data type.
      *
@@ -90,6 +204,19 @@ public:
      */
     virtual DataType data_type(column_t column) const = 0;
 
+    /**
+     * @brief Check if value is NULL.
+     *
+     * Check if the value of a given column of the result set is NULL.
+     *
+     * @param[in] column Column to check.
+     *
+     * @retval true - value is NULL.
+     * @retval false - value is not NULL.
+     * @throw std::logic_error in case of failure to get the data type.
+     */
+    virtual bool is_null(column_t column) const = 0;
+
     /**
      * @brief Get unsigned integer (8-bits).
      *
@@ -268,6 +395,215 @@ public:
      * @throw std::logic_error in case of failure to get BLOB.
      */
     virtual std::unique_ptr<const void*> blob(column_t column, size_t* size) const = 0;
+
+    /**
+     * @brief Get text view.
+     *
+     * Get text value from a given column of the result set without copying
+     * it. The text is valid until the result set moves to the next result.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the text got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get text.
+     */
+    virtual std::string_view text_view(column_t column) const = 0;
+
+    /**
+     * @brief Get BLOB view.
+     *
+     * Get BLOB value from a given column of the result set without copying
+     * it. The BLOB is valid until the result set moves to the next result.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the BLOB got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get BLOB.
+     */
+    virtual BlobView blob_view(column_t column) const = 0;
+
+    /**
+     * @brief Fetch batch.
+     *
+     * Fetch up to a given number of rows, starting from the current one, into
+     * the column-major buffers of a batch. Afterwards, the result set is
+     * positioned on the first row not fetched.
+     *
+     * The data type of each column is given by the first fetched row when
+     * the batch doesn't have the same number of columns as the result set.
+     * Otherwise, the data types of the batch are kept. A column is promoted
+     * when its values have different data types (see ColumnBatch), so no
+     * value is converted with loss.
+     *
+     * @param[out] batch Batch to store the rows.
+     * @param[in] rows Maximum number of rows to fetch.
+     *
+     * @return Number of fetched rows, zero when the result set finished.
+     * @throw std::invalid_argument in case of the values of a column can't be
+     * stored in the batch without loss.
+     * @throw std::logic_error in case of failure to fetch the rows.
+     */
+    virtual size_t fetch_batch(ColumnBatch& batch, size_t rows) = 0;
+
+    /**
+     * @brief Read fields.
+     *
+     * Read the first columns of the current row into the given fields, in
+     * order. All fields are read at once, without dispatching each column.
+     * A NULL column is read by a nullable field as std::nullopt.
+     *
+     * @param[out] fields Fields which shall receive the columns.
+     * @param[in] count Number of fields.
+     *
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of failure to read the columns.
+     */
+    virtual void read(const Field* fields, size_t count) const = 0;
+
+    /**
+     * @brief Get metadata.
+     *
+     * Get the metadata of the columns of the result set. The metadata is
+     * shared by all result sets of the same statement, so it can be kept to
+     * look up columns by name once, outside of the loops over the rows.
+     *
+     * @return Metadata of the result set.
+     * @throw std::logic_error in case of failure to get the metadata.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const ResultSetMetadata> metadata() const = 0;
+
+    /**
+     * @brief Get column index.
+     *
+     * Get the index of a column of the result set by its name.
+     *
+     * @param[in] name Name of the column.
+     *
+     * @return Index of the column.
+     * @throw std::invalid_argument in case there's no column with the given
+     * name.
+     */
+    [[nodiscard]] column_t column_index(std::string_view name) const {
+        return metadata()->index(name);
+    }
+
+    /**
+     * @brief Fetch row as type.
+     *
+     * Read the current row into the mapped members of a value.
+     *
+     * @tparam T Mapped type (see cppdbc::Mapping).
+     * @param[out] value Value which shall receive the columns.
+     *
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of failure to read the columns.
+     */
+    template<typename T>
+    void fetch_as(T& value) const {
+        auto fields = mapped_fields(value);
+        read(fields.data(), fields.size());
+    }
+
+    /**
+     * @brief Fetch row as type.
+     *
+     * Read the current row into a new value of a mapped type.
+     *
+     * @tparam T Mapped type (see cppdbc::Mapping).
+     *
+     * @return Value with the columns of the row.
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of failure to read the columns.
+     */
+    template<typename T>
+    [[nodiscard]] T fetch_as() const {
+        T value{};
+        fetch_as(value);
+        return value;
+    }
+
+    /**
+     * @brief Get value.
+     *
+     * Get value of the given type from a given column of the result set,
+     * calling the getter of the type.
+     *
+     * @tparam T Type of the value (integer, bool, float, double, string,
+     * string view or BLOB view), or an optional of any of them which is
+     * empty when the value is NULL.
+     * @param[in] column Column to get value.
+     *
+     * @return Value got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get value.
+     */
+    template<typename T>
+    [[nodiscard]] T get(column_t column) const {
+        if constexpr (is_optional<T>::value) {
+            if (is_null(column)) {
+                return std::nullopt;
+            }
+
+            return get<typename T::value_type>(column);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return boolean(column);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            if constexpr (sizeof(T) == sizeof(int8_t)) {
+                return int8(column);
+            } else if constexpr (sizeof(T) == sizeof(int16_t)) {
+                return int16(column);
+            } else if constexpr (sizeof(T) == sizeof(int32_t)) {
+                return int32(column);
+            } else {
+                return int64(column);
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (sizeof(T) == sizeof(uint8_t)) {
+                return uint8(column);
+            } else if constexpr (sizeof(T) == sizeof(uint16_t)) {
+                return uint16(column);
+            } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+                return uint32(column);
+            } else {
+                return uint64(column);
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            return flt(column);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(dbl(column));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return str(column);
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            return text_view(column);
+        } else if constexpr (std::is_same_v<T, BlobView>) {
+            return blob_view(column);
+        } else {
+            static_assert(unsupported<T>::value, "Unsupported column type");
+        }
+    }
+
+private:
+    /**
+     * @brief Unsupported type.
+     *
+     * Always false, used to reject unsupported types when instantiated.
+     */
+    template<typename T>
+    struct unsupported : std::false_type {};
+
+    /**
+     * @brief Check if type is optional.
+     */
+    template<typename T>
+    struct is_optional : std::false_type {};
+
+    template<typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
 };
 
 } // namespace cppdbc
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Result set metadata.
+ * @file
+ */
+
+#ifndef RESULT_SET_METADATA_HPP
+#define RESULT_SET_METADATA_HPP
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cppdbc {
+
+/**
+ * @brief Result set metadata.
+ *
+ * The metadata describes the columns of the result sets of a statement. It's
+ * computed once per statement and shared by all its result sets, so getting
+ * the index of a column by its name is a single hash lookup.
+ */
+class ResultSetMetadata {
+public:
+    /**
+     * @brief Column description.
+     *
+     * @note The origin table and column are empty when the database doesn't
+     * provide them (e.g. SQLite compiled without SQLITE_ENABLE_COLUMN_METADATA).
+     */
+    struct Column {
+        std::string name;             /*!< Name of the column in the result */
+        std::string declared_type;    /*!< Declared type, empty for expressions */
+        std::string table;            /*!< Origin table, empty for expressions */
+        std::string origin;           /*!< Origin column, empty for expressions */
+    };
+
+    /**
+     * @brief Create result set metadata.
+     *
+     * Constructor of the result set metadata.
+     *
+     * @param[in] columns Description of the columns, in order.
+     */
+    explicit ResultSetMetadata(std::vector<Column> columns) : columns_{std::move(columns)} {
+        index_.reserve(columns_.size());
+
+        // When many columns have the same name, the first one is found
+        for (size_t i = 0; i < columns_.size(); i++) {
+            index_.emplace(columns_[i].name, static_cast<uint16_t>(i));
+        }
+    }
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Result set metadata is not copyable, as it's shared.
+     */
+    ResultSetMetadata(const ResultSetMetadata&) = delete;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Result set metadata is not copyable, as it's shared.
+     */
+    ResultSetMetadata& operator=(const ResultSetMetadata&) = delete;
+
+    /**
+     * @brief Get number of columns.
+     *
+     * @return Number of columns of the result set.
+     */
+    [[nodiscard]] size_t column_count() const noexcept {
+        return columns_.size();
+    }
+
+    /**
+     * @brief Get column.
+     *
+     * @param[in] column Index of the column.
+     *
+     * @return Description of the column.
+     * @throw std::invalid_argument in case of invalid column.
+     */
+    [[nodiscard]] const Column& column(uint16_t column) const {
+        if (column >= columns_.size()) {
+            throw std::invalid_argument("Invalid column");
+        }
+
+        return columns_[column];
+    }
+
+    /**
+     * @brief Find column.
+     *
+     * Find the index of a column by its name.
+     *
+     * @param[in] name Name of the column.
+     *
+     * @return Index of the column, or std::nullopt when there's no column
+     * with the given name.
+     */
+    [[nodiscard]] std::optional<uint16_t> find(std::string_view name) const noexcept {
+        auto entry = index_.find(name);
+
+        if (entry == index_.end()) {
+            return std::nullopt;
+        }
+
+        return entry->second;
+    }
+
+    /**
+     * @brief Get column index.
+     *
+     * Get the index of a column by its name.
+     *
+     * @param[in] name Name of the column.
+     *
+     * @return Index of the column.
+     * @throw std::invalid_argument in case there's no column with the given
+     * name.
+     */
+    [[nodiscard]] uint16_t index(std::string_view name) const {
+        auto column = find(name);
+
+        if (!column) {
+            throw std::invalid_argument("Unknown column " + std::string(name));
+        }
+
+        return *column;
+    }
+
+private:
+    /**
+     * @brief Description of the columns.
+     */
+    std::vector<Column> columns_;
+
+    /**
+     * @brief Index of the columns by name.
+     *
+     * @note The keys are views of the names stored in the columns.
+     */
+    std::unordered_map<std::string_view, uint16_t> index_;
+};
+
+} // namespace cppdbc
+
+#endif // RESULT_SET_METADATA_HPP
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief SQLite connection pool.
+ * @file
+ */
+
+#ifndef SQLITE_CONNECTION_POOL_HPP
+#define SQLITE_CONNECTION_POOL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "sqlite_database.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief SQLite connection pool.
+ *
+ * A SQLite connection pool opens many connections to the same database file,
+ * in WAL journal mode, so many threads can read the database concurrently.
+ * Each connection has its own statement cache, and it's leased to a single
+ * thread at a time.
+ *
+ * When acquiring a connection, the pool prefers the idle connection last
+ * leased by the same thread, which keeps the caches of the connection warm
+ * on the same core.
+ */
+class SQLiteConnectionPool {
+public:
+    /**
+     * @brief Wait statistics.
+     *
+     * Counters of the acquisitions of connections from the pool.
+     */
+    struct WaitStats {
+        uint64_t acquisitions = 0;              /*!< Connections leased */
+        uint64_t affine = 0;                    /*!< Connections leased again to the same thread */
+        uint64_t waits = 0;                     /*!< Acquisitions which waited for a connection */
+        uint64_t timeouts = 0;                  /*!< Acquisitions which timed out */
+        std::chrono::nanoseconds total_wait{0}; /*!< Time spent waiting for connections */
+        std::chrono::nanoseconds max_wait{0};   /*!< Longest wait for a connection */
+    };
+
+    /**
+     * @brief Default busy timeout of the connections.
+     *
+     * Time which a connection waits for the locks held by other connections
+     * before failing, when the tuning of the pool has no busy timeout.
+     */
+    static constexpr std::chrono::milliseconds DEFAULT_BUSY_TIMEOUT{5000};
+
+private:
+    /**
+     * @brief State shared by the pool and its leases.
+     */
+    struct Shared;
+
+public:
+    /**
+     * @brief Connection lease.
+     *
+     * A lease gives exclusive access to a connection of the pool, and it
+     * returns the connection to the pool when it's destroyed.
+     */
+    class Lease {
+    public:
+        /**
+         * @brief Remove copy constructor.
+         *
+         * Lease is not copyable.
+         */
+        Lease(const Lease&) = delete;
+
+        /**
+         * @brief Move constructor.
+         *
+         * Move constructor of the lease.
+         */
+        Lease(Lease&& other) noexcept;
+
+        /**
+         * @brief Destroy lease.
+         *
+         * Destructor of the lease, which returns its connection to the pool.
+         */
+        ~Lease();
+
+        /**
+         * @brief Remove copy assignment.
+         *
+         * Lease is not copyable.
+         */
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * @brief Move assignment.
+         *
+         * Move assignment of the lease, which returns its current connection
+         * to the pool.
+         */
+        Lease& operator=(Lease&& other) noexcept;
+
+        /**
+         * @brief Check if lease has connection.
+         *
+         * @retval true - lease has a connection.
+         * @retval false - lease was released or moved.
+         */
+        explicit operator bool() const noexcept;
+
+        /**
+         * @brief Get connection.
+         *
+         * @return Leased connection.
+         * @throw std::logic_error in case of the lease has no connection.
+         */
+        SQLiteDatabase& operator*() const;
+
+        /**
+         * @brief Get connection.
+         *
+         * @return Pointer to the leased connection.
+         * @throw std::logic_error in case of the lease has no connection.
+         */
+        SQLiteDatabase* operator->() const;
+
+        /**
+         * @brief Release lease.
+         *
+         * Return the connection to the pool. The statements created from the
+         * connection which are still in use, including the ones kept alive by
+         * result sets and cursors, are invalidated, so using them afterwards
+         * fails instead of racing with the next lease of the connection.
+         *
+         * @note Typed statements, transactions and BLOB streams aren't
+         * invalidated, and they must not outlive the lease.
+         */
+        void release() noexcept;
+
+    private:
+        /**
+         * @brief SQLite connection pool is friend.
+         *
+         * Defining SQLite connection pool as friend of the lease, the pool
+         * can create leases.
+         */
+        friend class SQLiteConnectionPool;
+
+        /**
+         * @brief Create lease.
+         *
+         * @param[in] shared State shared by the pool and its leases.
+         * @param[in] index Index of the connection.
+         */
+        Lease(std::shared_ptr<Shared> shared, size_t index) noexcept;
+
+        /**
+         * @brief State shared by the pool and its leases.
+         */
+        std::shared_ptr<Shared> shared_;
+
+        /**
+         * @brief Index of the connection.
+         */
+        size_t index_ = 0;
+    };
+
+    /**
+     * @brief Create SQLite connection pool.
+     *
+     * Constructor of the SQLite connection pool, which opens all its
+     * connections. Unless the database is opened in read-only mode, its
+     * journal mode is set to WAL.
+     *
+     * @param[in] filename Path to the database file.
+     * @param[in] size Number of connections.
+     * @param[in] mode Mode to open the connections (in-memory is not
+     * supported, as each connection would have its own database).
+     *
+     * @throw std::invalid_argument in case of invalid size or mode, or
+     * failure to open the connections.
+     *
+     * @note The connections are opened in serialized mode, so a statement
+     * misused after its lease was released can't corrupt the connection.
+     * The multi-thread mode, without mutex, can be opted in through the
+     * options of the pool.
+     */
+    SQLiteConnectionPool(const std::string& filename, size_t size,
+            SQLiteDatabase::SQLiteMode mode = SQLiteDatabase::SQLiteMode::CREATE);
+
+    /**
+     * @brief Create SQLite connection pool with options.
+     *
+     * Constructor of the SQLite connection pool, which opens all its
+     * connections with the given options and tunes each one of them. Unless
+     * the database is opened in read-only mode or the tuning sets the journal
+     * mode, its journal mode is set to WAL.
+     *
+     * @param[in] filename Path or URI of the database file.
+     * @param[in] size Number of connections.
+     * @param[in] options Options to open the connections. The multi-thread
+     * mode saves the locking of the mutex on each call, but then nothing
+     * created from a lease may be used after the lease is released.
+     * @param[in] tuning Tuning of the connections. When it has no busy
+     * timeout, DEFAULT_BUSY_TIMEOUT is used.
+     *
+     * @throw std::invalid_argument in case of invalid size or mode, or
+     * failure to open or tune the connections.
+     */
+    SQLiteConnectionPool(const std::string& filename, size_t size,
+            const SQLiteDatabase::OpenOptions& options,
+            const SQLiteTuning& tuning = SQLiteTuning{});
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * SQLite connection pool is not copyable.
+     */
+    SQLiteConnectionPool(const SQLiteConnectionPool&) = delete;
+
+    /**
+     * @brief Destroy SQLite connection pool.
+     *
+     * Destructor of the SQLite connection pool. The connections which are
+     * still leased are closed when their leases are destroyed.
+     */
+    ~SQLiteConnectionPool() = default;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * SQLite connection pool is not copyable.
+     */
+    SQLiteConnectionPool& operator=(const SQLiteConnectionPool&) = delete;
+
+    /**
+     * @brief Acquire connection.
+     *
+     * Lease a connection of the pool, waiting until one is idle.
+     *
+     * @return Lease of the connection.
+     */
+    [[nodiscard]] Lease acquire();
+
+    /**
+     * @brief Try to acquire connection.
+     *
+     * Lease a connection of the pool, waiting up to a given time until one
+     * is idle.
+     *
+     * @param[in] timeout Maximum time to wait.
+     *
+     * @return Lease of the connection, or std::nullopt when the time is out.
+     */
+    [[nodiscard]] std::optional<Lease> try_acquire(std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief Get size.
+     *
+     * @return Number of connections of the pool.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Get number of idle connections.
+     *
+     * @return Number of connections which are not leased.
+     */
+    [[nodiscard]] size_t idle() const;
+
+    /**
+     * @brief Get wait statistics.
+     *
+     * @return Counters of the acquisitions of connections.
+     */
+    [[nodiscard]] WaitStats wait_stats() const;
+
+private:
+    /**
+     * @brief Acquire connection.
+     *
+     * @param[in] timeout Maximum time to wait, or std::nullopt to wait
+     * forever.
+     *
+     * @return Lease of the connection, or std::nullopt when the time is out.
+     */
+    std::optional<Lease> acquire(std::optional<std::chrono::nanoseconds> timeout);
+
+    /**
+     * @brief State shared by the pool and its leases.
+     */
+    std::shared_ptr<Shared> shared_;
+};
+
+} // namespace cppdbc
+
+#endif // SQLITE_CONNECTION_POOL_HPP
@@ -28,18 +28,29 @@
 #ifndef SQLITE_DATABASE_HPP
 #define SQLITE_DATABASE_HPP
 
+#include <list>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <sqlite3.h>
 
+#include "cppdbc/blob_stream.hpp"
 #include "cppdbc/database.hpp"
+#include "sqlite_tuning.hpp"
 
 namespace cppdbc {
 
 // Forward declarations
+class SQLiteBlobStream;
 class SQLiteStatement;
 class SQLiteTransaction;
 
+template<typename Parameters, typename Columns>
+class SQLiteTypedStatement;
+
 /**
  * @brief SQLite database.
  *
@@ -60,6 +71,59 @@ public:
         IN_MEMORY      /*!< In-memory */
     };
 
+    /**
+     * @brief Threading mode.
+     *
+     * Threading mode of the connection with the SQLite database. In the
+     * multi-thread mode, the connection doesn't lock its mutex on each call,
+     * so it shall not be used by more than one thread at the same time.
+     */
+    enum class ThreadingMode {
+        DEFAULT,         /*!< Mode the SQLite library was configured with */
+        MULTI_THREAD,    /*!< No mutex (SQLITE_OPEN_NOMUTEX) */
+        SERIALIZED       /*!< Mutex on each call (SQLITE_OPEN_FULLMUTEX) */
+    };
+
+    /**
+     * @brief Cache mode.
+     *
+     * Indicates if the connection shares the page cache with the other
+     * connections to the same database in the process.
+     */
+    enum class CacheMode {
+        DEFAULT,    /*!< Mode the SQLite library was configured with */
+        PRIVATE,    /*!< Private cache (SQLITE_OPEN_PRIVATECACHE) */
+        SHARED      /*!< Shared cache (SQLITE_OPEN_SHAREDCACHE) */
+    };
+
+    /**
+     * @brief Open options.
+     *
+     * Options used to open the connection with the SQLite database.
+     */
+    struct OpenOptions {
+        SQLiteMode mode = SQLiteMode::READ_ONLY;             /*!< Database mode */
+        ThreadingMode threading = ThreadingMode::DEFAULT;    /*!< Threading mode */
+        CacheMode cache = CacheMode::DEFAULT;                /*!< Cache mode */
+        bool uri = false;    /*!< Interpret the filename as URI (SQLITE_OPEN_URI) */
+    };
+
+    /**
+     * @brief Statement cache statistics.
+     *
+     * Counters of the prepared statement cache of the SQLite database.
+     */
+    struct StatementCacheStats {
+        uint64_t hits = 0;         /*!< Statements taken from the cache */
+        uint64_t misses = 0;       /*!< Statements prepared as not cached */
+        uint64_t evictions = 0;    /*!< Statements finalized to free space */
+    };
+
+    /**
+     * @brief Default capacity of the statement cache.
+     */
+    static constexpr size_t DEFAULT_STATEMENT_CACHE_CAPACITY = 16;
+
     /**
     * @brief Create SQLite database in read-only mode.
     *
@@ -83,6 +147,50 @@ public:
      */
     SQLiteDatabase(const std::string& filename, SQLiteMode mode);
 
+    /**
+     * @brief Create SQLite database with options.
+     *
+     * Constructor of the SQLite database which opens the connection with
+     * the given mode, threading mode and cache mode.
+     *
+     * @param[in] filename Path or URI of the database file.
+     * @param[in] options Options to open the database.
+     *
+     * @throw std::invalid_argument in case of failure to create database.
+     */
+    SQLiteDatabase(const std::string& filename, const OpenOptions& options);
+
+    /**
+     * @brief Create tuned SQLite database.
+     *
+     * Constructor of the SQLite database which applies the tuning once the
+     * connection is opened (see SQLiteDatabase::tune).
+     *
+     * @param[in] filename Path to the database file.
+     * @param[in] mode Mode to create database.
+     * @param[in] tuning Performance settings of the database.
+     *
+     * @throw std::invalid_argument in case of failure to create database, or
+     * to apply any setting.
+     */
+    SQLiteDatabase(const std::string& filename, SQLiteMode mode, const SQLiteTuning& tuning);
+
+    /**
+     * @brief Create tuned SQLite database with options.
+     *
+     * Constructor of the SQLite database which opens the connection with the
+     * given options and applies the tuning (see SQLiteDatabase::tune).
+     *
+     * @param[in] filename Path or URI of the database file.
+     * @param[in] options Options to open the database.
+     * @param[in] tuning Performance settings of the database.
+     *
+     * @throw std::invalid_argument in case of failure to create database, or
+     * to apply any setting.
+     */
+    SQLiteDatabase(const std::string& filename, const OpenOptions& options,
+            const SQLiteTuning& tuning);
+
     /**
      * @brief Remove copy constructor.
      *
@@ -93,7 +201,9 @@ public:
     /**
      * @brief Move constructor.
      *
-     * Move constructor of the SQLite database.
+     * Move constructor of the SQLite database. The statements created from
+     * the moved database which are still in use are invalidated (see
+     * invalidate_statements), as they refer to the moved database.
      */
     SQLiteDatabase(SQLiteDatabase&& other) noexcept;
 
@@ -114,7 +224,9 @@ public:
     /**
      * @brief Move assignment.
      *
-     * Move SQLite database to new reference.
+     * Move SQLite database to new reference. The statements created from
+     * both databases which are still in use are invalidated (see
+     * invalidate_statements).
      */
     SQLiteDatabase& operator=(SQLiteDatabase&& other) noexcept;
 
@@ -134,6 +246,10 @@ public:
      *
      * Create SQL statement to be executed in the SQLite database.
      *
+     * When the statement cache is enabled, a statement previously prepared
+     * with the same query is reused if it's not in use. Once the statement
+     * is released, it's reset and returned to the cache.
+     *
      * @param[in] query SQL to be executed.
      *
      * @return Pointer to the created statement.
@@ -153,6 +269,21 @@ public:
      */
     std::shared_ptr<Transaction> create_transaction() override;
 
+    /**
+     * @brief Execute script.
+     *
+     * Execute all SQL statements of the script in order. Each statement is
+     * prepared from the remaining of the script and executed in place,
+     * without creating statement or result set objects. The execution stops
+     * at the first statement which fails.
+     *
+     * @param[in] script SQL statements to be executed.
+     *
+     * @throw cppdbc::script_error in case of failure to execute a statement.
+     * @throw std::logic_error in case of invalid database.
+     */
+    void execute_script(std::string_view script) override;
+
     /**
      * @brief Check if table exists.
      *
@@ -166,7 +297,93 @@ public:
      */
     bool has_table(const std::string& tableName) override;
 
+    /**
+     * @brief Open BLOB stream.
+     *
+     * Open a stream to read and write a BLOB of the SQLite database in
+     * chunks. To write a new BLOB, the row shall be inserted with a
+     * zero-filled BLOB of the final size (see Statement::bind_zeroblob).
+     *
+     * @param[in] table Name of the table.
+     * @param[in] column Name of the column.
+     * @param[in] rowid Row ID of the row which the BLOB belongs to.
+     * @param[in] writable Indicates if the BLOB can be written.
+     *
+     * @return Pointer to the opened BLOB stream.
+     * @throw std::invalid_argument in case of failure to open the BLOB.
+     * @throw std::logic_error in case of invalid database.
+     */
+    std::shared_ptr<BlobStream> open_blob(const std::string& table, const std::string& column,
+            int64_t rowid, bool writable = false);
+
+    /**
+     * @brief Tune database.
+     *
+     * Apply the performance settings of the tuning which have a value. Each
+     * pragma setting is read back from the database afterwards, and the first
+     * one which didn't take effect fails the tuning.
+     *
+     * @note SQLite has no way to read the lookaside configuration back, so
+     * the lookaside setting only fails the tuning when SQLite rejects it.
+     *
+     * @param[in] tuning Performance settings of the database.
+     *
+     * @throw std::invalid_argument in case of failure to apply any setting.
+     * @throw std::logic_error in case of invalid database.
+     */
+    void tune(const SQLiteTuning& tuning);
+
+    /**
+     * @brief Invalidate statements.
+     *
+     * Invalidate the statements created from the database which are still in
+     * use, including the ones kept alive by result sets and cursors. They are
+     * finalized and detached from the database, so they no longer touch the
+     * connection nor its statement cache, and using them fails afterwards.
+     *
+     * @note It must be called from the thread which uses the statements.
+     * Typed statements, transactions and BLOB streams aren't invalidated.
+     */
+    void invalidate_statements() noexcept;
+
+    /**
+     * @brief Set statement cache capacity.
+     *
+     * Set the maximum number of idle prepared statements kept in the cache.
+     * When the cache is full, the least recently used statement is finalized.
+     * A capacity of zero disables the cache.
+     *
+     * @param[in] capacity Maximum number of cached statements.
+     */
+    void set_statement_cache_capacity(size_t capacity);
+
+    /**
+     * @brief Get statement cache capacity.
+     *
+     * Get the maximum number of idle prepared statements kept in the cache.
+     *
+     * @return Capacity of the statement cache.
+     */
+    [[nodiscard]] size_t statement_cache_capacity() const noexcept;
+
+    /**
+     * @brief Get statement cache statistics.
+     *
+     * Get the counters of hits, misses and evictions of the statement cache.
+     *
+     * @return Statistics of the statement cache.
+     */
+    [[nodiscard]] StatementCacheStats statement_cache_stats() const noexcept;
+
 private:
+    /**
+     * @brief SQLite BLOB stream is friend.
+     *
+     * Defining SQLite BLOB stream as friend of the SQLite database, the
+     * stream can open BLOBs directly.
+     */
+    friend class SQLiteBlobStream;
+
     /**
      * @brief SQLite statement is friend.
      *
@@ -175,6 +392,15 @@ private:
      */
     friend class SQLiteStatement;
 
+    /**
+     * @brief SQLite typed statement is friend.
+     *
+     * Defining SQLite typed statement as friend of the SQLite database, the
+     * typed statement can execute the queries directly.
+     */
+    template<typename Parameters, typename Columns>
+    friend class SQLiteTypedStatement;
+
     /**
      * @brief SQLite transaction is friend.
      *
@@ -195,10 +421,110 @@ private:
      */
     static int32_t parse_sqlite_mode(SQLiteMode mode);
 
+    /**
+     * @brief Parse open options.
+     *
+     * Parse the open options to SQLite flags used to open the connection
+     * with the database.
+     *
+     * @param[in] options Options used to create the database connection.
+     *
+     * @return SQLite flags.
+     */
+    static int32_t parse_open_options(const OpenOptions& options);
+
+    /**
+     * @brief Apply pragma.
+     *
+     * Set the value of the pragma, and read it back to check that the value
+     * took effect.
+     *
+     * @param[in] name Name of the pragma.
+     * @param[in] value Value of the pragma, as read back from the database.
+     *
+     * @throw std::invalid_argument in case of the pragma has another value.
+     */
+    void apply_pragma(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Query pragma.
+     *
+     * Get the current value of the pragma as text.
+     *
+     * @param[in] name Name of the pragma.
+     *
+     * @return Value of the pragma, or an empty string when it has no value.
+     * @throw std::invalid_argument in case of failure to query the pragma.
+     */
+    std::string query_pragma(const std::string& name);
+
+    /**
+     * @brief Release statement.
+     *
+     * Forget a statement which is no longer in use and, when the cache is
+     * enabled, return it back to the cache. The statement is reset and its
+     * bindings cleared, so it's ready to be used again.
+     *
+     * @param[in] query Query used to prepare the statement.
+     * @param[in] statement Statement to be released.
+     */
+    void release_statement(std::string query, std::unique_ptr<SQLiteStatement> statement);
+
+    /**
+     * @brief Evict statements.
+     *
+     * Finalize the least recently used statements until the cache has no more
+     * statements than its capacity.
+     */
+    void evict_statements();
+
+    /**
+     * @brief Clear statement cache.
+     *
+     * Finalize all statements in the cache.
+     */
+    void clear_statement_cache() noexcept;
+
+    /**
+     * @brief Cached statements.
+     *
+     * Idle statements ordered from the most to the least recently used.
+     */
+    using StatementCache = std::list<std::pair<std::string, std::unique_ptr<SQLiteStatement>>>;
+
     /**
      * @brief SQLite database handler.
      */
     sqlite3* sqlite_ = nullptr;
+
+    /**
+     * @brief Maximum number of cached statements.
+     */
+    size_t cache_capacity_ = DEFAULT_STATEMENT_CACHE_CAPACITY;
+
+    /**
+     * @brief Statement cache statistics.
+     */
+    StatementCacheStats cache_stats_;
+
+    /**
+     * @brief Idle statements.
+     */
+    StatementCache cache_;
+
+    /**
+     * @brief Index of the idle statements by query.
+     *
+     * @note The keys are views of the queries stored in the cache.
+     */
+    std::unordered_map<std::string_view, StatementCache::iterator> cache_index_;
+
+    /**
+     * @brief Statements in use.
+     *
+     * Statements created from the database which weren't released yet.
+     */
+    std::vector<SQLiteStatement*> statements_;
 };
 
 } // namespace cppdbc
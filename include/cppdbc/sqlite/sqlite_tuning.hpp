@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief SQLite tuning.
+ * @file
+ */
+
+#ifndef SQLITE_TUNING_HPP
+#define SQLITE_TUNING_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace cppdbc {
+
+/**
+ * @brief SQLite tuning.
+ *
+ * The tuning declares the performance settings applied to a SQLite database
+ * when it's opened. Only the settings which have a value are applied, and
+ * each one, except the lookaside, is read back from the database to check
+ * that it took effect.
+ *
+ * The named profiles (see SQLiteTuning::preset) cover the most common uses of
+ * a database, and any of their settings can be changed afterwards.
+ */
+struct SQLiteTuning {
+    /**
+     * @brief Journal mode.
+     *
+     * Mode of the journal used to roll back transactions (PRAGMA journal_mode).
+     */
+    enum class JournalMode {
+        DEFAULT,     /*!< Keep the current journal mode */
+        DELETE,      /*!< Rollback journal deleted at the end of transactions */
+        TRUNCATE,    /*!< Rollback journal truncated at the end of transactions */
+        PERSIST,     /*!< Rollback journal kept at the end of transactions */
+        MEMORY,      /*!< Rollback journal in memory */
+        WAL,         /*!< Write-ahead log */
+        OFF          /*!< No journal (transactions can't be rolled back safely) */
+    };
+
+    /**
+     * @brief Synchronous mode.
+     *
+     * How often the database waits for the data to be written to disk
+     * (PRAGMA synchronous).
+     */
+    enum class Synchronous {
+        DEFAULT,    /*!< Keep the current synchronous mode */
+        OFF,        /*!< Never wait (the database may be corrupted on power loss) */
+        NORMAL,     /*!< Wait at critical moments (durable in WAL mode, except on power loss) */
+        FULL,       /*!< Wait at the end of each transaction */
+        EXTRA       /*!< Wait also for the rollback journal to be deleted */
+    };
+
+    /**
+     * @brief Temporary store.
+     *
+     * Location of the temporary tables and indices (PRAGMA temp_store).
+     */
+    enum class TempStore {
+        DEFAULT,    /*!< Keep the current temporary store */
+        FILE,       /*!< Temporary files */
+        MEMORY      /*!< Memory */
+    };
+
+    /**
+     * @brief Tuning profile.
+     *
+     * Named set of settings for a use of the database.
+     */
+    enum class Profile {
+        DURABLE,               /*!< No committed transaction is lost, even on power loss */
+        THROUGHPUT,            /*!< Concurrent reads and writes, durable except on power loss */
+        BULK_LOAD,             /*!< Loading large amounts of data, not durable */
+        READ_ONLY_ANALYTICS    /*!< Large scans of a database which isn't written */
+    };
+
+    /**
+     * @brief Lookaside memory allocator.
+     *
+     * Size and number of the slots of the lookaside memory allocator of the
+     * connection, used for small and short-lived allocations.
+     */
+    struct Lookaside {
+        uint32_t slot_size;    /*!< Size of each slot, in bytes (multiple of 8) */
+        uint32_t slots;        /*!< Number of slots */
+    };
+
+    JournalMode journal_mode = JournalMode::DEFAULT;    /*!< Journal mode */
+    Synchronous synchronous = Synchronous::DEFAULT;     /*!< Synchronous mode */
+    TempStore temp_store = TempStore::DEFAULT;          /*!< Temporary store */
+
+    /**
+     * @brief Size of the page cache.
+     *
+     * Number of pages when positive, or number of KiB when negative.
+     */
+    std::optional<int64_t> cache_size;
+
+    /**
+     * @brief Size of the memory-mapped I/O, in bytes.
+     *
+     * @note It's limited by the maximum size the SQLite library was built
+     * with, and a larger size fails the verification.
+     */
+    std::optional<int64_t> mmap_size;
+
+    /**
+     * @brief Size of the pages, in bytes.
+     *
+     * @note It only takes effect on databases which have no content yet and
+     * aren't in WAL mode.
+     */
+    std::optional<uint32_t> page_size;
+
+    /**
+     * @brief Lookaside memory allocator.
+     *
+     * @note It can't be read back, so it isn't verified. SQLite may still
+     * use fewer slots when it fails to allocate them.
+     */
+    std::optional<Lookaside> lookaside;
+
+    /**
+     * @brief Time to wait for the locks held by other connections.
+     */
+    std::optional<std::chrono::milliseconds> busy_timeout;
+
+    /**
+     * @brief Get tuning of profile.
+     *
+     * Get the settings of a named profile.
+     *
+     * @param[in] profile Tuning profile.
+     *
+     * @return Tuning with the settings of the profile.
+     *
+     * @note The profiles which change the journal mode require a database
+     * file, as in-memory databases can't use the WAL mode.
+     */
+    static SQLiteTuning preset(Profile profile) {
+        SQLiteTuning tuning;
+
+        switch (profile) {
+            case Profile::DURABLE:
+                tuning.journal_mode = JournalMode::WAL;
+                tuning.synchronous = Synchronous::FULL;
+                tuning.cache_size = -16 * 1024;
+                tuning.busy_timeout = std::chrono::milliseconds(5000);
+                break;
+
+            case Profile::THROUGHPUT:
+                tuning.journal_mode = JournalMode::WAL;
+                tuning.synchronous = Synchronous::NORMAL;
+                tuning.temp_store = TempStore::MEMORY;
+                tuning.cache_size = -64 * 1024;
+                tuning.mmap_size = 256 * 1024 * 1024;
+                tuning.lookaside = Lookaside{1200, 500};
+                tuning.busy_timeout = std::chrono::milliseconds(5000);
+                break;
+
+            case Profile::BULK_LOAD:
+                tuning.journal_mode = JournalMode::MEMORY;
+                tuning.synchronous = Synchronous::OFF;
+                tuning.temp_store = TempStore::MEMORY;
+                tuning.cache_size = -256 * 1024;
+                tuning.lookaside = Lookaside{1200, 1000};
+                tuning.busy_timeout = std::chrono::milliseconds(30000);
+                break;
+
+            case Profile::READ_ONLY_ANALYTICS:
+                tuning.temp_store = TempStore::MEMORY;
+                tuning.cache_size = -256 * 1024;
+                tuning.mmap_size = 1024 * 1024 * 1024;
+                tuning.busy_timeout = std::chrono::milliseconds(5000);
+                break;
+        }
+
+        return tuning;
+    }
+};
+
+} // namespace cppdbc
+
+#endif // SQLITE_TUNING_HPP
@@ -0,0 +1,538 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief SQLite typed statement.
+ * @file
+ */
+
+#ifndef SQLITE_TYPED_STATEMENT_HPP
+#define SQLITE_TYPED_STATEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlite3.h>
+
+#include "cppdbc/exception.hpp"
+#include "sqlite_database.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief SQLite typed statement.
+ *
+ * The types of the parameters and the columns of the statement are given as
+ * tuples.
+ *
+ * @tparam Parameters Tuple with the types of the parameters.
+ * @tparam Columns Tuple with the types of the columns.
+ */
+template<typename Parameters, typename Columns>
+class SQLiteTypedStatement;
+
+/**
+ * @brief SQLite typed statement.
+ *
+ * A typed statement has the types of its parameters and columns fixed at
+ * compile time. The parameters are bound and the columns are read calling
+ * SQLite directly for each type, without virtual calls. Only the SQLite type
+ * of each value is checked against the type of its column: bool and integers
+ * read INTEGER values, floating points read INTEGER and FLOAT values, texts
+ * read TEXT values and BLOBs read BLOB values.
+ *
+ * The supported types are bool, integers, floating points, std::string,
+ * std::string_view, std::vector<std::byte> and std::optional of them, which
+ * maps NULL to std::nullopt. NULL is also read as an empty BLOB, but it
+ * can't be read by any other type which isn't optional. A std::string_view
+ * column is valid until the statement moves to the next row.
+ *
+ * @tparam Parameters Types of the parameters.
+ * @tparam Columns Types of the columns.
+ */
+template<typename... Parameters, typename... Columns>
+class SQLiteTypedStatement<std::tuple<Parameters...>, std::tuple<Columns...>> {
+public:
+    /**
+     * @brief Row of the statement.
+     */
+    using Row = std::tuple<Columns...>;
+
+    /**
+     * @brief Create SQLite typed statement.
+     *
+     * Constructor of the SQLite typed statement. The number of parameters and
+     * columns of the query must match the number of types of the statement.
+     *
+     * @param[in] database SQLite database which the statement shall be
+     * created.
+     * @param[in] query SQL to be executed.
+     *
+     * @throw std::invalid_argument in case of invalid database, invalid query
+     * or the query doesn't match the types of the statement.
+     */
+    SQLiteTypedStatement(const std::shared_ptr<SQLiteDatabase>& database,
+            const std::string& query) :
+            database_{database} {
+
+        if (database_ == nullptr || database_->sqlite_ == nullptr) {
+            throw std::invalid_argument("Cannot create statement for invalid database");
+        }
+
+        int result = sqlite3_prepare_v3(database_->sqlite_, query.c_str(),
+                static_cast<int>(query.size()), SQLITE_PREPARE_PERSISTENT, &statement_,
+                nullptr);
+
+        if (result != SQLITE_OK) {
+            sqlite3_finalize(statement_);
+            throw std::invalid_argument("Failed to create statement");
+        }
+
+        if (sqlite3_bind_parameter_count(statement_) != sizeof...(Parameters) ||
+                sqlite3_column_count(statement_) != sizeof...(Columns)) {
+
+            sqlite3_finalize(statement_);
+            throw std::invalid_argument("Query doesn't match the types of the statement");
+        }
+    }
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * SQLite typed statement is not copyable.
+     */
+    SQLiteTypedStatement(const SQLiteTypedStatement&) = delete;
+
+    /**
+     * @brief Move constructor.
+     *
+     * Move constructor of the SQLite typed statement.
+     */
+    SQLiteTypedStatement(SQLiteTypedStatement&& other) noexcept :
+            statement_{other.statement_},
+            database_{std::move(other.database_)} {
+
+        other.statement_ = nullptr;
+    }
+
+    /**
+     * @brief Destroy SQLite typed statement.
+     *
+     * Destructor of the SQLite typed statement.
+     */
+    ~SQLiteTypedStatement() {
+        if (statement_ != nullptr) {
+            sqlite3_finalize(statement_);
+        }
+    }
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * SQLite typed statement is not copyable.
+     */
+    SQLiteTypedStatement& operator=(const SQLiteTypedStatement&) = delete;
+
+    /**
+     * @brief Move assignment.
+     *
+     * Move assignment of the SQLite typed statement.
+     */
+    SQLiteTypedStatement& operator=(SQLiteTypedStatement&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (statement_ != nullptr) {
+            sqlite3_finalize(statement_);
+        }
+
+        statement_ = other.statement_;
+        database_ = std::move(other.database_);
+        other.statement_ = nullptr;
+
+        return *this;
+    }
+
+    /**
+     * @brief Bind parameters.
+     *
+     * Reset the statement and bind the parameters to it. Text and BLOB
+     * parameters are copied, so they don't need to outlive the call.
+     *
+     * @param[in] parameters Values of the parameters.
+     *
+     * @throw std::invalid_argument in case of failure to bind the parameters.
+     * @throw std::logic_error in case of invalid statement.
+     */
+    void bind(const Parameters&... parameters) {
+        reset();
+        bind_parameters(std::index_sequence_for<Parameters...>{}, SQLITE_TRANSIENT,
+                parameters...);
+    }
+
+    /**
+     * @brief Move to next row.
+     *
+     * Execute the statement until the next row is available.
+     *
+     * @retval true - the next row is available.
+     * @retval false - no more rows are available.
+     * @throw cppdbc::constraint_violation in case of constraint violation.
+     * @throw std::logic_error in case of invalid statement or failure to
+     * execute the statement.
+     */
+    bool next() {
+        check_statement();
+
+        switch (sqlite3_step(statement_)) {
+            case SQLITE_ROW:
+                return true;
+            case SQLITE_DONE:
+                return false;
+            case SQLITE_CONSTRAINT:
+                throw constraint_violation();
+            default:
+                throw std::logic_error("Failed to execute SQLite statement");
+        }
+    }
+
+    /**
+     * @brief Get row.
+     *
+     * Get the columns of the current row.
+     *
+     * @return Row with the values of the columns.
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     */
+    [[nodiscard]] Row row() const {
+        return row_as<Row>();
+    }
+
+    /**
+     * @brief Get row as type.
+     *
+     * Get the columns of the current row as an aggregate, which is
+     * initialized with the columns in order.
+     *
+     * @tparam T Type of the aggregate.
+     *
+     * @return Aggregate with the values of the columns.
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     */
+    template<typename T>
+    [[nodiscard]] T row_as() const {
+        return row_as<T>(std::index_sequence_for<Columns...>{});
+    }
+
+    /**
+     * @brief Execute statement.
+     *
+     * Bind the parameters and execute the statement until it's completed.
+     * Text and BLOB parameters are not copied, so the statement is reset and
+     * its bindings are cleared before returning.
+     *
+     * @param[in] parameters Values of the parameters.
+     *
+     * @return Number of rows modified by the statement.
+     * @throw std::invalid_argument in case of failure to bind the parameters.
+     * @throw cppdbc::constraint_violation in case of constraint violation.
+     * @throw std::logic_error in case of invalid statement or failure to
+     * execute the statement.
+     */
+    uint64_t execute(const Parameters&... parameters) {
+        reset();
+
+        // The parameters aren't bound after they're destroyed by the caller
+        ResetGuard guard{statement_, true};
+        bind_parameters(std::index_sequence_for<Parameters...>{}, SQLITE_STATIC,
+                parameters...);
+
+        while (next()) {}
+
+        return static_cast<uint64_t>(sqlite3_changes(database_->sqlite_));
+    }
+
+    /**
+     * @brief Execute statement for each row.
+     *
+     * Bind the parameters and call the function with each row of the
+     * statement. The statement is reset afterwards, even when the function
+     * throws an exception.
+     *
+     * @param[in] function Function called with each row.
+     * @param[in] parameters Values of the parameters.
+     *
+     * @throw std::invalid_argument in case of failure to bind the parameters,
+     * or a column doesn't have the expected data type.
+     * @throw std::logic_error in case of invalid statement or failure to
+     * execute the statement.
+     */
+    template<typename Function>
+    void for_each(Function&& function, const Parameters&... parameters) {
+        bind(parameters...);
+        ResetGuard guard{statement_, false};
+
+        while (next()) {
+            std::apply(function, row());
+        }
+    }
+
+    /**
+     * @brief Reset statement.
+     *
+     * Reset the statement, so it can be executed again. The parameters bound
+     * by bind() are kept, while execute() clears its parameters.
+     *
+     * @throw std::logic_error in case of invalid statement.
+     */
+    void reset() {
+        check_statement();
+        sqlite3_reset(statement_);
+    }
+
+private:
+    /**
+     * @brief Reset guard.
+     *
+     * Reset the statement when it goes out of scope, clearing its bindings
+     * if required.
+     */
+    struct ResetGuard {
+        sqlite3_stmt* statement;    /*!< SQLite statement handler */
+        bool clear_bindings;        /*!< Indicates if the bindings are cleared */
+
+        ~ResetGuard() {
+            sqlite3_reset(statement);
+
+            if (clear_bindings) {
+                sqlite3_clear_bindings(statement);
+            }
+        }
+    };
+
+    /**
+     * @brief Check statement.
+     *
+     * @throw std::logic_error in case of invalid statement.
+     */
+    void check_statement() const {
+        if (statement_ == nullptr) {
+            throw std::logic_error("Invalid statement");
+        }
+    }
+
+    /**
+     * @brief Bind parameters.
+     *
+     * @param[in] destructor SQLite destructor of text and BLOB parameters.
+     * @param[in] parameters Values of the parameters.
+     *
+     * @throw std::invalid_argument in case of failure to bind the parameters.
+     */
+    template<size_t... I>
+    void bind_parameters(std::index_sequence<I...> /*indexes*/, sqlite3_destructor_type destructor,
+            const Parameters&... parameters) {
+
+        bool bound = (true && ... &&
+                (bind_value(static_cast<int>(I) + 1, parameters, destructor) == SQLITE_OK));
+
+        if (!bound) {
+            throw std::invalid_argument("Failed to bind parameters");
+        }
+    }
+
+    /**
+     * @brief Bind value.
+     *
+     * @param[in] index SQLite index of the parameter.
+     * @param[in] value Value to be bound.
+     * @param[in] destructor SQLite destructor of text and BLOB values.
+     *
+     * @return SQLite result.
+     */
+    template<typename T>
+    int bind_value(int index, const T& value, sqlite3_destructor_type destructor) {
+        if constexpr (is_optional<T>::value) {
+            if (!value) {
+                return sqlite3_bind_null(statement_, index);
+            }
+
+            return bind_value(index, *value, destructor);
+        } else if constexpr (std::is_integral_v<T>) {
+            return sqlite3_bind_int64(statement_, index, static_cast<sqlite3_int64>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return sqlite3_bind_double(statement_, index, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view text = value;
+
+            return sqlite3_bind_text(statement_, index, text.data() != nullptr ? text.data() : "",
+                    static_cast<int>(text.size()), destructor);
+        } else if constexpr (std::is_same_v<T, std::vector<std::byte>>) {
+            return sqlite3_bind_blob(statement_, index, value.data(),
+                    static_cast<int>(value.size()), destructor);
+        } else {
+            static_assert(unsupported<T>::value, "Unsupported parameter type");
+        }
+    }
+
+    /**
+     * @brief Get row as type.
+     *
+     * @return Aggregate with the values of the columns.
+     */
+    template<typename T, size_t... I>
+    [[nodiscard]] T row_as(std::index_sequence<I...> /*indexes*/) const {
+        return T{column<Columns>(static_cast<int>(I))...};
+    }
+
+    /**
+     * @brief Get column.
+     *
+     * @param[in] index SQLite index of the column.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case the column doesn't have the
+     * expected data type.
+     */
+    template<typename T>
+    [[nodiscard]] T column(int index) const {
+        int type = sqlite3_column_type(statement_, index);
+
+        if constexpr (is_optional<T>::value) {
+            if (type == SQLITE_NULL) {
+                return std::nullopt;
+            }
+
+            return value<typename T::value_type>(index, type);
+        } else {
+            return value<T>(index, type);
+        }
+    }
+
+    /**
+     * @brief Get value.
+     *
+     * @param[in] index SQLite index of the column.
+     * @param[in] type SQLite type of the value.
+     *
+     * @return Value of the column.
+     * @throw std::invalid_argument in case the value doesn't have the
+     * expected data type.
+     */
+    template<typename T>
+    [[nodiscard]] T value(int index, int type) const {
+        if (!readable<T>(type)) {
+            throw std::invalid_argument("Column doesn't have the expected data type");
+        }
+
+        if constexpr (std::is_same_v<T, bool>) {
+            return sqlite3_column_int(statement_, index) != 0;
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t)) {
+            return static_cast<T>(sqlite3_column_int(statement_, index));
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(sqlite3_column_int64(statement_, index));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(sqlite3_column_double(statement_, index));
+        } else if constexpr (std::is_same_v<T, std::string> ||
+                std::is_same_v<T, std::string_view>) {
+
+            // The size must be read after the text to get the size of the text
+            auto text = reinterpret_cast<const char*>(sqlite3_column_text(statement_, index));
+            auto size = static_cast<size_t>(sqlite3_column_bytes(statement_, index));
+
+            return text != nullptr ? T(text, size) : T();
+        } else if constexpr (std::is_same_v<T, std::vector<std::byte>>) {
+            auto blob = static_cast<const std::byte*>(sqlite3_column_blob(statement_, index));
+            auto size = static_cast<size_t>(sqlite3_column_bytes(statement_, index));
+
+            return blob != nullptr ? T(blob, blob + size) : T();
+        } else {
+            static_assert(unsupported<T>::value, "Unsupported column type");
+        }
+    }
+
+    /**
+     * @brief Check if value is readable.
+     *
+     * @param[in] type SQLite type of the value.
+     *
+     * @retval true - the value can be read as the type without conversion.
+     * @retval false - the value has another data type.
+     */
+    template<typename T>
+    [[nodiscard]] static constexpr bool readable(int type) noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return type == SQLITE_INTEGER;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return type == SQLITE_FLOAT || type == SQLITE_INTEGER;
+        } else if constexpr (std::is_same_v<T, std::vector<std::byte>>) {
+            return type == SQLITE_BLOB || type == SQLITE_NULL;
+        } else {
+            return type == SQLITE_TEXT;
+        }
+    }
+
+    /**
+     * @brief Check if type is optional.
+     */
+    template<typename T>
+    struct is_optional : std::false_type {};
+
+    /**
+     * @brief Check if type is optional.
+     */
+    template<typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    /**
+     * @brief Unsupported type.
+     *
+     * Always false, used to reject unsupported types when instantiated.
+     */
+    template<typename T>
+    struct unsupported : std::false_type {};
+
+    /**
+     * @brief SQLite statement handler.
+     */
+    sqlite3_stmt* statement_ = nullptr;
+
+    /**
+     * @brief SQLite database object.
+     */
+    std::shared_ptr<SQLiteDatabase> database_;
+};
+
+} // namespace cppdbc
+
+#endif // SQLITE_TYPED_STATEMENT_HPP
@@ -28,10 +28,60 @@
 #ifndef STATEMENT_HPP
 #define STATEMENT_HPP
 
+#include <array>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cursor.hpp"
+#include "parameter.hpp"
+
 namespace cppdbc {
 
-// Forward declarations
-class ResultSet;
+/**
+ * @brief Batch result.
+ *
+ * Result of the execution of a statement over many rows of parameters.
+ */
+struct BatchResult {
+    /**
+     * @brief Number of changed rows.
+     *
+     * Number of database rows changed by each executed row of parameters.
+     */
+    std::vector<uint64_t> changes;
+
+    /**
+     * @brief Failed row.
+     *
+     * Index of the first row of parameters which failed, if any.
+     */
+    std::optional<size_t> failed_row;
+
+    /**
+     * @brief Failure.
+     *
+     * Exception raised by the failed row, if any.
+     */
+    std::exception_ptr error;
+
+    /**
+     * @brief Check if the batch succeeded.
+     *
+     * @retval true - all rows were executed.
+     * @retval false - a row failed.
+     */
+    [[nodiscard]] bool succeeded() const noexcept {
+        return !failed_row.has_value();
+    }
+};
 
 /**
  * @brief SQL statement.
@@ -40,6 +90,16 @@ class ResultSet;
  */
 class Statement {
 public:
+    /**
+     * @brief Value lifetime.
+     *
+     * Lifetime of a value bound to the statement without being owned by it.
+     */
+    enum class Lifetime {
+        STATIC,       /*!< Value outlives the statement's use of it, not copied */
+        TRANSIENT     /*!< Value may be gone after binding, copied */
+    };
+
     /**
      * @brief Destroy statement.
      *
@@ -52,7 +112,7 @@ public:
      *
      * Check if the statement is pending. When a statement is created it
      * shall be pending and can be executed only once. After that, it shall
-     * not be pending anymore.
+     * not be pending anymore until it is reset.
      *
      * @retval true - statement pending.
      * @retval false - statement is not pending.
@@ -73,6 +133,189 @@ public:
      */
     virtual std::shared_ptr<ResultSet> execute() = 0;
 
+    /**
+     * @brief Query statement.
+     *
+     * Execute the statement and get a cursor to its result set. Unlike
+     * execute(), the result set is owned by the statement, so no memory is
+     * allocated to query the statement. The cursor keeps the statement alive
+     * while it has a row, so it can be used on a temporary statement.
+     *
+     * @return Cursor positioned on the first row, or an empty cursor when
+     * there are no rows.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    virtual Cursor query() = 0;
+
+    /**
+     * @brief Get metadata.
+     *
+     * Get the metadata of the columns of the results of the statement, which
+     * is known even when the statement has no rows.
+     *
+     * @return Metadata of the results.
+     * @throw std::logic_error in case of failure to get the metadata.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const ResultSetMetadata> metadata() const = 0;
+
+    /**
+     * @brief Get rows.
+     *
+     * Execute the statement and get an input range over its rows. The range
+     * keeps the statement alive, so it can be used on a temporary statement.
+     *
+     * @code
+     * for (auto& row : statement->rows()) {
+     *     std::cout << row.int64(0) << std::endl;
+     * }
+     * @endcode
+     *
+     * @return Range over the rows of the statement.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    Rows rows() {
+        return Rows(query());
+    }
+
+    /**
+     * @brief Get prefetched rows.
+     *
+     * Execute the statement and get an input range over its rows, which are
+     * fetched in background, in batches of the given number of rows (see
+     * PrefetchingResultSet). The statement must not be used while the range
+     * exists.
+     *
+     * @param[in] prefetch Number of rows of each prefetched batch.
+     *
+     * @return Range over the rows of the statement.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::invalid_argument in case of invalid number of rows.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    Rows rows(size_t prefetch) {
+        return Rows(query(), prefetch);
+    }
+
+    /**
+     * @brief Query scalar.
+     *
+     * Execute the statement and get the value of the first column of the
+     * first row. The statement is reset afterwards, keeping its bindings.
+     *
+     * @tparam T Type of the value.
+     *
+     * @return Value of the column, or std::nullopt when there are no rows.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::invalid_argument in case the column doesn't have the
+     * expected type.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    template<typename T>
+    std::optional<T> query_scalar() {
+        return query_first<T>([](const ResultSet& result) {
+            return result.get<T>(0);
+        });
+    }
+
+    /**
+     * @brief Query one row.
+     *
+     * Execute the statement and get the columns of the first row as a tuple.
+     * The statement is reset afterwards, keeping its bindings.
+     *
+     * @tparam Tuple Tuple with the types of the columns.
+     *
+     * @return Tuple with the values of the columns, or std::nullopt when
+     * there are no rows.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * type.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    template<typename Tuple>
+    std::optional<Tuple> query_one() {
+        return query_first<Tuple>([](const ResultSet& result) {
+            return get_tuple<Tuple>(result, std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+        });
+    }
+
+    /**
+     * @brief Reset statement.
+     *
+     * Reset the statement back to its initial state, so it can be executed
+     * again without being prepared again. The bound values are kept, and any
+     * result set created by a previous execution becomes invalid.
+     *
+     * @throw std::logic_error in case of failure to reset the statement.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Clear bindings.
+     *
+     * Clear all values bound to the statement. Every parameter of the
+     * statement is set back to NULL.
+     *
+     * @throw std::logic_error in case of failure to clear the bindings.
+     */
+    virtual void clear_bindings() = 0;
+
+    /**
+     * @brief Execute batch.
+     *
+     * Execute the statement once for each row of parameters. Each row can be
+     * a tuple-like object (e.g. std::tuple, std::pair or std::array), whose
+     * elements are bound in order starting from index 0, or a single value
+     * bound to index 0.
+     *
+     * All rows are executed within a single transaction, unless a transaction
+     * is already open. When a row fails, the execution stops. If the batch
+     * opened the transaction, it's rolled back. Otherwise, the rows executed
+     * before the failure stay applied (as listed by BatchResult::changes),
+     * and the caller decides whether to roll back its transaction.
+     *
+     * @param[in] rows Container of rows of parameters.
+     *
+     * @return Result of the batch.
+     * @throw std::logic_error in case of failure to execute the batch.
+     */
+    template<typename Container>
+    BatchResult execute_batch(const Container& rows) {
+        auto row = std::begin(rows);
+
+        return execute_batch(static_cast<size_t>(std::distance(std::begin(rows), std::end(rows))),
+                [this, &row]() { bind_row(*row++); });
+    }
+
+    /**
+     * @brief Execute batch.
+     *
+     * Execute the statement a given number of times. Before each execution,
+     * the parameters of the next row are bound by a given function.
+     *
+     * All rows are executed within a single transaction, unless a transaction
+     * is already open. When a row fails, the execution stops. If the batch
+     * opened the transaction, it's rolled back. Otherwise, the rows executed
+     * before the failure stay applied (as listed by BatchResult::changes),
+     * and the caller decides whether to roll back its transaction.
+     *
+     * @param[in] rows Number of rows.
+     * @param[in] bind_next_row Function which binds the next row of
+     * parameters.
+     *
+     * @return Result of the batch.
+     * @throw std::logic_error in case of failure to execute the batch.
+     */
+    virtual BatchResult execute_batch(size_t rows,
+            const std::function<void()>& bind_next_row) = 0;
+
     /**
      * @brief Bind unsigned integer (8-bits).
      *
@@ -203,6 +446,53 @@ public:
      */
     virtual void bind(const std::string& value, uint16_t index) = 0;
 
+    /**
+     * @brief Bind string.
+     *
+     * Bind string value to a given index of the statement, moving the string
+     * into the statement. The string is released once the value is no longer
+     * bound, without being copied.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    virtual void bind(std::string&& value, uint16_t index) = 0;
+
+    /**
+     * @brief Bind string view.
+     *
+     * Bind string view to a given index of the statement. With a static
+     * lifetime, the string is not copied and must remain valid until the
+     * statement is executed and the value is no longer bound (rebound,
+     * cleared or the statement destroyed).
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     * @param[in] lifetime Lifetime of the value.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    virtual void bind(std::string_view value, uint16_t index, Lifetime lifetime) = 0;
+
+    /**
+     * @brief Bind shared string.
+     *
+     * Bind shared string to a given index of the statement. The statement
+     * shares the ownership of the string, without copying it, until the
+     * value is no longer bound.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of invalid string or failure to
+     * bind the value to column.
+     */
+    virtual void bind(std::shared_ptr<const std::string> value, uint16_t index) = 0;
+
     /**
      * @brief Bind float.
      *
@@ -232,7 +522,9 @@ public:
     /**
      * @brief Bind BLOB.
      *
-     * Bind BLOB to a given index of the statement.
+     * Bind BLOB to a given index of the statement. The memory is not copied
+     * and must remain valid until the statement is executed and the value is
+     * no longer bound (rebound, cleared or the statement destroyed).
      *
      * @param[in] value Pointer to memory location to be bound.
      * @param[in] size Number of bytes of the bound memory.
@@ -242,6 +534,352 @@ public:
      * column.
      */
     virtual void bind(const void* value, size_t size, uint16_t index) = 0;
+
+    /**
+     * @brief Bind BLOB with lifetime.
+     *
+     * Bind BLOB to a given index of the statement. With a static lifetime,
+     * the memory is not copied and must remain valid until the value is no
+     * longer bound. With a transient lifetime, the memory is copied.
+     *
+     * @param[in] value Pointer to memory location to be bound.
+     * @param[in] size Number of bytes of the bound memory.
+     * @param[in] index Index which the value shall be bound.
+     * @param[in] lifetime Lifetime of the value.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    virtual void bind(const void* value, size_t size, uint16_t index, Lifetime lifetime) = 0;
+
+    /**
+     * @brief Bind BLOB.
+     *
+     * Bind BLOB to a given index of the statement, moving the vector into the
+     * statement. The vector is released once the value is no longer bound,
+     * without being copied.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    virtual void bind(std::vector<std::byte>&& value, uint16_t index) = 0;
+
+    /**
+     * @brief Bind BLOB.
+     *
+     * Bind BLOB to a given index of the statement, transferring the ownership
+     * of the memory to the statement. The memory is released once the value
+     * is no longer bound, without being copied.
+     *
+     * @param[in] value Memory to be bound.
+     * @param[in] size Number of bytes of the bound memory.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column, or the BLOB is too large (in which case the caller keeps the
+     * ownership of the memory).
+     */
+    virtual void bind(std::unique_ptr<std::byte[]>&& value, size_t size, uint16_t index) = 0;
+
+    /**
+     * @brief Bind shared BLOB.
+     *
+     * Bind shared BLOB to a given index of the statement. The statement
+     * shares the ownership of the vector, without copying it, until the
+     * value is no longer bound.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of invalid BLOB or failure to bind
+     * the value to column.
+     */
+    virtual void bind(std::shared_ptr<const std::vector<std::byte>> value, uint16_t index) = 0;
+
+    /**
+     * @brief Bind zero-filled BLOB.
+     *
+     * Bind a BLOB filled with zeros to a given index of the statement,
+     * without allocating its memory. The BLOB can be written later in chunks
+     * through a BLOB stream.
+     *
+     * @param[in] size Number of bytes of the BLOB.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    virtual void bind_zeroblob(uint64_t size, uint16_t index) = 0;
+
+    /**
+     * @brief Bind NULL.
+     *
+     * Bind NULL to a given index of the statement.
+     *
+     * @param[in] index Index which NULL shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind NULL to column.
+     */
+    virtual void bind(std::nullopt_t, uint16_t index) = 0;
+
+    /**
+     * @brief Bind parameters.
+     *
+     * Bind many parameters at once to consecutive indexes of the statement,
+     * starting from a given index.
+     *
+     * @param[in] parameters Pointer to the parameters to be bound.
+     * @param[in] count Number of parameters.
+     * @param[in] index Index which the first parameter shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind any parameter.
+     *
+     * @note Text and BLOB values aren't copied, so they must outlive the
+     * execution of the statement (see cppdbc::Parameter).
+     */
+    virtual void bind_parameters(const Parameter* parameters, size_t count, uint16_t index) = 0;
+
+    /**
+     * @brief Get parameter index.
+     *
+     * Get the index of a named parameter (e.g. :name, @name or $name) of the
+     * statement. The index can be kept and used to bind values to the
+     * parameter without looking up its name again.
+     *
+     * @param[in] name Name of the parameter, including its prefix.
+     *
+     * @return Index of the parameter.
+     * @throw std::invalid_argument in case of the statement doesn't have a
+     * parameter with the given name.
+     */
+    [[nodiscard]] virtual uint16_t parameter_index(std::string_view name) const = 0;
+
+    /**
+     * @brief Bind optional value.
+     *
+     * Bind the value of an optional to a given index of the statement, or
+     * NULL when the optional is empty.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    template<typename T>
+    void bind(const std::optional<T>& value, uint16_t index) {
+        if (value) {
+            bind(*value, index);
+        } else {
+            bind(std::nullopt, index);
+        }
+    }
+
+    /**
+     * @brief Bind named parameter.
+     *
+     * Bind value to a named parameter (e.g. :name, @name or $name) of the
+     * statement.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] name Name of the parameter, including its prefix.
+     *
+     * @throw std::invalid_argument in case of unknown parameter or failure to
+     * bind the value.
+     *
+     * @note Text and BLOB values aren't copied, so they must outlive the
+     * execution of the statement (see cppdbc::Parameter). Temporary strings
+     * and vectors of bytes are moved into the statement instead.
+     */
+    template<typename T, typename Name, std::enable_if_t<
+            std::is_convertible_v<const T&, Parameter> &&
+            std::is_convertible_v<const Name&, std::string_view> &&
+            !std::is_integral_v<Name>, int> = 0>
+    void bind(T&& value, const Name& name) {
+        if constexpr (is_temporary_memory<T>::value) {
+            bind(std::forward<T>(value), parameter_index(name));
+        } else {
+            const Parameter parameter(value);
+            bind_parameters(&parameter, 1, parameter_index(name));
+        }
+    }
+
+    /**
+     * @brief Bind all values.
+     *
+     * Bind all given values in order, starting from index 0. The type of
+     * each value is resolved at compile time and all values are bound at
+     * once, without allocating memory.
+     *
+     * @param[in] values Values to be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind any value.
+     *
+     * @note Text and BLOB values aren't copied, so they must outlive the
+     * execution of the statement. Temporary strings and vectors of bytes
+     * are rejected at compile time.
+     */
+    template<typename... Args>
+    void bind_all(Args&&... values) {
+        static_assert(!(is_temporary_memory<Args>::value || ...),
+                "Text and BLOB values must outlive the execution of the statement");
+
+        const std::array<Parameter, sizeof...(Args)> parameters{Parameter(values)...};
+        bind_parameters(parameters.data(), parameters.size(), 0);
+    }
+
+    /**
+     * @brief Bind from value.
+     *
+     * Bind the mapped members of a value to the parameters of the statement,
+     * in order, starting from index 0.
+     *
+     * @tparam T Mapped type (see cppdbc::Mapping).
+     * @param[in] value Value to be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the values.
+     *
+     * @note The value must outlive the execution of the statement, as its
+     * text and BLOB members aren't copied.
+     */
+    template<typename T>
+    void bind_from(T&& value) {
+        std::apply([this, &value](auto... members) {
+            bind_all(std::forward<T>(value).*members...);
+        }, Mapping<std::decay_t<T>>::fields);
+    }
+
+    /**
+     * @brief Bind tuple.
+     *
+     * Bind all elements of a tuple-like object (e.g. std::tuple, std::pair or
+     * std::array) in order, starting from index 0.
+     *
+     * @param[in] values Tuple of values to be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind any value.
+     *
+     * @note The tuple must outlive the execution of the statement, as its
+     * text and BLOB elements aren't copied.
+     */
+    template<typename Tuple>
+    void bind_tuple(Tuple&& values) {
+        std::apply([this](auto&&... value) {
+            bind_all(std::forward<decltype(value)>(value)...);
+        }, std::forward<Tuple>(values));
+    }
+
+private:
+    /**
+     * @brief Check if type owns memory.
+     *
+     * Types whose memory would be bound without being copied.
+     */
+    template<typename T>
+    struct owns_memory : std::false_type {};
+
+    template<typename T>
+    struct owns_memory<std::optional<T>> : owns_memory<T> {};
+
+    template<typename Char, typename Traits, typename Allocator>
+    struct owns_memory<std::basic_string<Char, Traits, Allocator>> : std::true_type {};
+
+    template<typename Allocator>
+    struct owns_memory<std::vector<std::byte, Allocator>> : std::true_type {};
+
+    /**
+     * @brief Check if argument is temporary memory.
+     *
+     * Arguments which own memory and are destroyed once the binding returns.
+     */
+    template<typename T>
+    struct is_temporary_memory : std::bool_constant<!std::is_lvalue_reference_v<T> &&
+            owns_memory<std::decay_t<T>>::value> {};
+
+    /**
+     * @brief Check if type is tuple-like.
+     */
+    template<typename T, typename = void>
+    struct is_tuple_like : std::false_type {};
+
+    template<typename T>
+    struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> :
+            std::true_type {};
+
+    /**
+     * @brief Bind row.
+     *
+     * Bind a row of parameters starting from index 0.
+     *
+     * @param[in] row Row of parameters.
+     */
+    template<typename Row>
+    void bind_row(const Row& row) {
+        if constexpr (is_tuple_like<Row>::value) {
+            bind_tuple(row);
+        } else {
+            bind_all(row);
+        }
+    }
+
+    /**
+     * @brief Query first row.
+     *
+     * Query the statement, read the first row and reset the statement.
+     *
+     * @param[in] read Function which reads the row.
+     *
+     * @return Value read from the row, or std::nullopt when there are no rows.
+     */
+    template<typename T, typename Read>
+    std::optional<T> query_first(const Read& read) {
+        std::optional<T> value;
+
+        // The cursor is destroyed before the statement is reset
+        ResetGuard guard{*this};
+        Cursor cursor = query();
+
+        if (cursor) {
+            value = read(*cursor);
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Reset guard.
+     *
+     * Reset the statement when it goes out of scope. A failure to reset is
+     * ignored, so it doesn't replace the exception being propagated.
+     */
+    struct ResetGuard {
+        Statement& statement;    /*!< Statement to be reset */
+
+        ~ResetGuard() {
+            try {
+                statement.reset();
+            } catch (...) {
+                // The statement is invalid, so there's nothing to reset
+            }
+        }
+    };
+
+    /**
+     * @brief Get tuple.
+     *
+     * Get the columns of the current row of a result set as a tuple.
+     *
+     * @param[in] result Result set positioned on the row.
+     *
+     * @return Tuple with the values of the columns.
+     */
+    template<typename Tuple, size_t... I>
+    static Tuple get_tuple(const ResultSet& result, std::index_sequence<I...> /*indexes*/) {
+        return Tuple{result.get<std::tuple_element_t<I, Tuple>>(static_cast<column_t>(I))...};
+    }
 };
 
 } // namespace cppdbc
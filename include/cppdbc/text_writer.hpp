@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief Text writer.
+ * @file
+ */
+
+#ifndef TEXT_WRITER_HPP
+#define TEXT_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "resultset.hpp"
+#include "statement.hpp"
+
+namespace cppdbc {
+
+/**
+ * @brief Text writer.
+ *
+ * A text writer exports result sets as CSV (RFC 4180) or newline-delimited
+ * JSON (one object per row). The output is formatted into a large buffer,
+ * which is written to the output stream or file descriptor only when it's
+ * full, and no memory is allocated per row.
+ *
+ * Values are written as follows:
+ *
+ * - INTEGER and FLOAT: numbers (non-finite floats are null in JSON).
+ * - TEXT: quoted only when needed in CSV, always quoted in JSON.
+ * - BLOB: hexadecimal digits, quoted in JSON.
+ * - NULL: empty field in CSV, null in JSON.
+ */
+class TextWriter {
+public:
+    /**
+     * @brief Text format.
+     */
+    enum class Format {
+        CSV,        /*!< Comma-separated values, with a header row */
+        NDJSON      /*!< Newline-delimited JSON objects */
+    };
+
+    /**
+     * @brief Default size of the output buffer.
+     */
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    /**
+     * @brief Create text writer to stream.
+     *
+     * Constructor of the text writer which writes to an output stream.
+     *
+     * @param[in] output Output stream which the text is written.
+     * @param[in] format Text format.
+     * @param[in] buffer_size Size of the output buffer.
+     *
+     * @throw std::invalid_argument in case of the buffer is smaller than 64
+     * bytes.
+     */
+    TextWriter(std::ostream& output, Format format, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * @brief Create text writer to file descriptor.
+     *
+     * Constructor of the text writer which writes to a file descriptor. The
+     * file descriptor is not closed by the writer.
+     *
+     * @param[in] descriptor File descriptor which the text is written.
+     * @param[in] format Text format.
+     * @param[in] buffer_size Size of the output buffer.
+     *
+     * @throw std::invalid_argument in case of invalid file descriptor or the
+     * buffer is smaller than 64 bytes.
+     */
+    TextWriter(int descriptor, Format format, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * Text writer is not copyable.
+     */
+    TextWriter(const TextWriter&) = delete;
+
+    /**
+     * @brief Destroy text writer.
+     *
+     * Destructor of the text writer, which writes the buffered text. Errors
+     * are ignored, so flush() shall be called to check them.
+     */
+    ~TextWriter();
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * Text writer is not copyable.
+     */
+    TextWriter& operator=(const TextWriter&) = delete;
+
+    /**
+     * @brief Set CSV delimiter.
+     *
+     * Set the character which separates the fields of CSV rows. The default
+     * delimiter is comma.
+     *
+     * @param[in] delimiter Delimiter of the fields.
+     *
+     * @throw std::invalid_argument in case of the delimiter is a quote or a
+     * line break.
+     */
+    void set_delimiter(char delimiter);
+
+    /**
+     * @brief Set CSV header.
+     *
+     * Enable or disable writing the names of the columns as the first row of
+     * CSV. The header is enabled by default.
+     *
+     * @param[in] enabled Indicates if the header shall be written.
+     */
+    void set_header(bool enabled) noexcept;
+
+    /**
+     * @brief Write result set.
+     *
+     * Write the current and the remaining rows of a result set. The CSV
+     * header is written only once, before the first row.
+     *
+     * @param[in] result Result set positioned on its first row to be written.
+     *
+     * @return Number of written rows.
+     * @throw std::logic_error in case of failure to read the rows or to write
+     * the output.
+     */
+    size_t write(ResultSet& result);
+
+    /**
+     * @brief Write statement.
+     *
+     * Query a statement and write all its rows. When the statement has no
+     * rows, the CSV header is still written from the metadata of the
+     * statement. Afterwards, the statement is reset.
+     *
+     * @param[in] statement Statement to be queried.
+     *
+     * @return Number of written rows.
+     * @throw std::logic_error in case of failure to query the statement or
+     * to write the output.
+     */
+    size_t write(Statement& statement);
+
+    /**
+     * @brief Flush writer.
+     *
+     * Write the buffered text to the output.
+     *
+     * @throw std::logic_error in case of failure to write the output.
+     */
+    void flush();
+
+private:
+    /**
+     * @brief Write CSV header.
+     *
+     * @param[in] metadata Metadata of the result set.
+     */
+    void write_header(const ResultSetMetadata& metadata);
+
+    /**
+     * @brief Write CSV row.
+     *
+     * @param[in] result Result set positioned on the row.
+     * @param[in] columns Number of columns.
+     */
+    void write_csv_row(const ResultSet& result, size_t columns);
+
+    /**
+     * @brief Write JSON row.
+     *
+     * @param[in] result Result set positioned on the row.
+     * @param[in] keys Escaped keys of the columns, with their separators.
+     */
+    void write_json_row(const ResultSet& result, const std::vector<std::string>& keys);
+
+    /**
+     * @brief Write CSV field.
+     *
+     * @param[in] text Text of the field, quoted when needed.
+     */
+    void write_csv_text(std::string_view text);
+
+    /**
+     * @brief Write JSON string.
+     *
+     * @param[in] text Text of the string, which is escaped.
+     */
+    void write_json_text(std::string_view text);
+
+    /**
+     * @brief Write BLOB as hexadecimal digits.
+     *
+     * @param[in] blob BLOB to be written.
+     */
+    void write_hex(BlobView blob);
+
+    /**
+     * @brief Write number.
+     *
+     * @param[in] value Number to be written.
+     */
+    template<typename T>
+    void write_number(T value);
+
+    /**
+     * @brief Append text to buffer.
+     *
+     * @param[in] text Text to be appended.
+     */
+    void append(std::string_view text);
+
+    /**
+     * @brief Append character to buffer.
+     *
+     * @param[in] c Character to be appended.
+     */
+    void append(char c);
+
+    /**
+     * @brief Reserve space in buffer.
+     *
+     * Flush the buffer when it doesn't have the given number of bytes
+     * available.
+     *
+     * @param[in] size Number of bytes, up to the size of the buffer.
+     *
+     * @return Pointer to the available space.
+     */
+    char* reserve(size_t size);
+
+    /**
+     * @brief Write bytes to output.
+     *
+     * @param[in] data Pointer to the bytes.
+     * @param[in] size Number of bytes.
+     */
+    void output(const char* data, size_t size);
+
+    /**
+     * @brief Output stream, or null pointer for file descriptors.
+     */
+    std::ostream* stream_ = nullptr;
+
+    /**
+     * @brief Output file descriptor.
+     */
+    int descriptor_ = -1;
+
+    /**
+     * @brief Text format.
+     */
+    Format format_;
+
+    /**
+     * @brief Delimiter of CSV fields.
+     */
+    char delimiter_ = ',';
+
+    /**
+     * @brief Indicates if the CSV header shall be written.
+     */
+    bool header_ = true;
+
+    /**
+     * @brief Indicates if the CSV header was written.
+     */
+    bool header_written_ = false;
+
+    /**
+     * @brief Output buffer.
+     */
+    std::vector<char> buffer_;
+
+    /**
+     * @brief Number of used bytes of the output buffer.
+     */
+    size_t used_ = 0;
+};
+
+} // namespace cppdbc
+
+#endif // TEXT_WRITER_HPP
@@ -0,0 +1,557 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cppdbc/arrow_writer.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace cppdbc {
+
+namespace {
+
+// Identifiers of the Arrow flatbuffer schemas (Message.fbs and Schema.fbs)
+constexpr int16_t METADATA_VERSION_V5 = 4;
+constexpr uint8_t HEADER_SCHEMA = 1;
+constexpr uint8_t HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_NULL = 1;
+constexpr uint8_t TYPE_INT = 2;
+constexpr uint8_t TYPE_FLOATING_POINT = 3;
+constexpr uint8_t TYPE_LARGE_BINARY = 19;
+constexpr uint8_t TYPE_LARGE_UTF8 = 20;
+constexpr int16_t PRECISION_DOUBLE = 2;
+
+constexpr uint32_t CONTINUATION = 0xFFFFFFFF;
+constexpr std::string_view MAGIC = "ARROW1";
+constexpr size_t ALIGNMENT = 8;
+
+/**
+ * @brief Flatbuffer builder.
+ *
+ * Minimal flatbuffer builder for the Arrow metadata. As the official
+ * builder, the buffer is built from its end, so the children are created
+ * before their parents and the offsets are distances from the end of the
+ * buffer.
+ *
+ * @note The bytes are kept in reverse order, so they're appended instead of
+ * prepended.
+ */
+class FlatBufferBuilder {
+public:
+    void start_table() {
+        fields_.clear();
+        table_start_ = size();
+    }
+
+    template<typename T>
+    void add_scalar(uint16_t field, T value) {
+        prepend(value);
+        fields_.emplace_back(field, size());
+    }
+
+    void add_offset(uint16_t field, uint32_t offset) {
+        prepend_offset(offset);
+        fields_.emplace_back(field, size());
+    }
+
+    uint32_t end_table() {
+        prepend<int32_t>(0);
+        uint32_t table = size();
+
+        uint16_t count = 0;
+        for (const auto& field : fields_) {
+            count = std::max<uint16_t>(count, field.first + 1);
+        }
+
+        std::vector<uint16_t> vtable(count, 0);
+        for (const auto& field : fields_) {
+            vtable[field.first] = static_cast<uint16_t>(table - field.second);
+        }
+
+        for (size_t i = count; i > 0; i--) {
+            prepend<uint16_t>(vtable[i - 1]);
+        }
+
+        prepend<uint16_t>(static_cast<uint16_t>(table - table_start_));
+        prepend<uint16_t>(static_cast<uint16_t>((count + 2) * sizeof(uint16_t)));
+
+        // The table refers to its vtable, which is placed right before it
+        auto vtable_offset = static_cast<int32_t>(size() - table);
+        patch(table, vtable_offset);
+        fields_.clear();
+
+        return table;
+    }
+
+    uint32_t create_string(std::string_view value) {
+        align(value.size() + 1, sizeof(uint32_t));
+        bytes_.push_back(0);
+        prepend_bytes(value.data(), value.size());
+        prepend(static_cast<uint32_t>(value.size()));
+
+        return size();
+    }
+
+    uint32_t create_offsets(const std::vector<uint32_t>& offsets) {
+        align(offsets.size() * sizeof(uint32_t), sizeof(uint32_t));
+
+        for (size_t i = offsets.size(); i > 0; i--) {
+            prepend_offset(offsets[i - 1]);
+        }
+
+        prepend(static_cast<uint32_t>(offsets.size()));
+
+        return size();
+    }
+
+    uint32_t create_structs(const std::vector<uint8_t>& structs, size_t count) {
+        align(structs.size(), ALIGNMENT);
+        prepend_bytes(structs.data(), structs.size());
+        prepend(static_cast<uint32_t>(count));
+
+        return size();
+    }
+
+    std::vector<uint8_t> finish(uint32_t root) {
+        align(sizeof(uint32_t), max_alignment_);
+        prepend_offset(root);
+
+        return std::vector<uint8_t>(bytes_.rbegin(), bytes_.rend());
+    }
+
+private:
+    [[nodiscard]] uint32_t size() const noexcept {
+        return static_cast<uint32_t>(bytes_.size());
+    }
+
+    void align(size_t size, size_t alignment) {
+        max_alignment_ = std::max(max_alignment_, alignment);
+        bytes_.resize(bytes_.size() + (alignment - (bytes_.size() + size) % alignment) % alignment);
+    }
+
+    void prepend_bytes(const void* data, size_t size) {
+        auto bytes = static_cast<const uint8_t*>(data);
+
+        for (size_t i = size; i > 0; i--) {
+            bytes_.push_back(bytes[i - 1]);
+        }
+    }
+
+    template<typename T>
+    void prepend(T value) {
+        align(sizeof(T), sizeof(T));
+        prepend_bytes(&value, sizeof(T));
+    }
+
+    void prepend_offset(uint32_t offset) {
+        align(sizeof(uint32_t), sizeof(uint32_t));
+        prepend(size() + static_cast<uint32_t>(sizeof(uint32_t)) - offset);
+    }
+
+    void patch(uint32_t at, int32_t value) {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+
+        for (size_t i = 0; i < sizeof(value); i++) {
+            bytes_[at - 1 - i] = bytes[i];
+        }
+    }
+
+    std::vector<uint8_t> bytes_;
+    std::vector<std::pair<uint16_t, uint32_t>> fields_;
+    uint32_t table_start_ = 0;
+    size_t max_alignment_ = 1;
+};
+
+uint32_t create_schema(FlatBufferBuilder& builder, const std::vector<std::string>& names,
+        const std::vector<ResultSet::DataType>& types) {
+
+    std::vector<uint32_t> fields;
+    fields.reserve(names.size());
+
+    for (size_t i = 0; i < names.size(); i++) {
+        uint8_t type_type = TYPE_NULL;
+        builder.start_table();
+
+        if (i < types.size()) {
+            switch (types[i]) {
+                case ResultSet::DataType::INTEGER:
+                    type_type = TYPE_INT;
+                    builder.add_scalar<int32_t>(0, 64);
+                    builder.add_scalar<uint8_t>(1, 1);
+                    break;
+                case ResultSet::DataType::FLOAT:
+                    type_type = TYPE_FLOATING_POINT;
+                    builder.add_scalar<int16_t>(0, PRECISION_DOUBLE);
+                    break;
+                case ResultSet::DataType::TEXT:
+                    type_type = TYPE_LARGE_UTF8;
+                    break;
+                case ResultSet::DataType::BLOB:
+                    type_type = TYPE_LARGE_BINARY;
+                    break;
+                case ResultSet::DataType::NULL_VALUE:
+                    break;
+            }
+        }
+
+        uint32_t type = builder.end_table();
+        uint32_t name = builder.create_string(names[i]);
+        uint32_t children = builder.create_offsets({});
+
+        builder.start_table();
+        builder.add_offset(0, name);
+        builder.add_offset(3, type);
+        builder.add_offset(5, children);
+        builder.add_scalar<uint8_t>(1, 1);
+        builder.add_scalar<uint8_t>(2, type_type);
+        fields.push_back(builder.end_table());
+    }
+
+    uint32_t vector = builder.create_offsets(fields);
+
+    builder.start_table();
+    builder.add_offset(1, vector);
+    return builder.end_table();
+}
+
+std::vector<ResultSet::DataType> column_types(const ColumnBatch& batch) {
+    std::vector<ResultSet::DataType> types;
+    types.reserve(batch.columns.size());
+
+    for (const auto& column : batch.columns) {
+        types.push_back(column.type);
+    }
+
+    return types;
+}
+
+template<typename T>
+void append(std::vector<uint8_t>& buffer, const T& value) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+ArrowWriter::ArrowWriter(std::ostream& output, Format format) :
+        output_{output},
+        format_{format} {}
+
+size_t ArrowWriter::write(ResultSet& result, size_t rows) {
+    if (closed_) {
+        throw std::logic_error("Cannot write to closed Arrow writer");
+    }
+
+    if (rows == 0) {
+        throw std::invalid_argument("Invalid number of rows per batch");
+    }
+
+    auto metadata = result.metadata();
+    std::vector<std::string> names;
+    names.reserve(metadata->column_count());
+
+    for (size_t i = 0; i < metadata->column_count(); i++) {
+        names.push_back(metadata->column(static_cast<column_t>(i)).name);
+    }
+
+    if (names_.empty()) {
+        names_ = names;
+    } else if (names != names_) {
+        throw std::logic_error("Columns don't match the Arrow schema");
+    }
+
+    size_t written = 0;
+    size_t count;
+
+    // Until the schema is written, the batches are held while any column
+    // has only NULL values, so its data type is given by the later rows
+    std::vector<ColumnBatch> held;
+
+    while ((count = result.fetch_batch(batch_, rows)) > 0) {
+        written += count;
+
+        if (!schema_written_) {
+            bool untyped = std::any_of(batch_.columns.begin(), batch_.columns.end(),
+                    [](const auto& column) { return column.type == ResultSet::DataType::NULL_VALUE; });
+
+            if (untyped) {
+                held.push_back(batch_);
+                continue;
+            }
+
+            write_schema(names, column_types(batch_));
+            write_batches(held);
+        }
+
+        write_batch(batch_);
+    }
+
+    // The columns which have only NULL values have the Null type
+    if (!schema_written_ && !held.empty()) {
+        write_schema(names, column_types(held.back()));
+        write_batches(held);
+    }
+
+    return written;
+}
+
+size_t ArrowWriter::write(Statement& statement, size_t rows) {
+    if (closed_) {
+        throw std::logic_error("Cannot write to closed Arrow writer");
+    }
+
+    if (rows == 0) {
+        throw std::invalid_argument("Invalid number of rows per batch");
+    }
+
+    Cursor cursor = statement.query();
+    size_t written = 0;
+
+    try {
+        if (cursor) {
+            written = write(*cursor, rows);
+        } else {
+            write_schema(*statement.metadata());
+        }
+    } catch (...) {
+        statement.reset();
+        throw;
+    }
+
+    statement.reset();
+
+    return written;
+}
+
+void ArrowWriter::close() {
+    if (closed_) {
+        return;
+    }
+
+    if (!schema_written_) {
+        write_schema(names_, {});
+    }
+
+    // End of stream
+    uint32_t end[] = {CONTINUATION, 0};
+    write_bytes(end, sizeof(end));
+
+    if (format_ == Format::FILE) {
+        std::vector<uint8_t> blocks;
+
+        for (const auto& block : blocks_) {
+            append(blocks, block.offset);
+            append(blocks, block.metadata_size);
+            append(blocks, int32_t(0));
+            append(blocks, block.body_size);
+        }
+
+        FlatBufferBuilder builder;
+        uint32_t schema = create_schema(builder, names_, types_);
+        uint32_t batches = builder.create_structs(blocks, blocks_.size());
+
+        builder.start_table();
+        builder.add_offset(1, schema);
+        builder.add_offset(3, batches);
+        builder.add_scalar<int16_t>(0, METADATA_VERSION_V5);
+        auto footer = builder.finish(builder.end_table());
+        auto size = static_cast<int32_t>(footer.size());
+
+        write_bytes(footer.data(), footer.size());
+        write_bytes(&size, sizeof(size));
+        write_bytes(MAGIC.data(), MAGIC.size());
+    }
+
+    output_.flush();
+    closed_ = true;
+}
+
+void ArrowWriter::write_schema(const ResultSetMetadata& metadata) {
+    std::vector<std::string> names;
+    std::vector<ResultSet::DataType> types;
+    names.reserve(metadata.column_count());
+    types.reserve(metadata.column_count());
+
+    // The declared types give the data types, as there's no row
+    for (size_t i = 0; i < metadata.column_count(); i++) {
+        const auto& column = metadata.column(static_cast<column_t>(i));
+
+        names.push_back(column.name);
+        types.push_back(ColumnBatch::data_type(column.declared_type));
+    }
+
+    if (!names_.empty() && names != names_) {
+        throw std::logic_error("Columns don't match the Arrow schema");
+    }
+
+    if (!schema_written_) {
+        write_schema(names, types);
+    }
+}
+
+void ArrowWriter::write_schema(const std::vector<std::string>& names,
+        const std::vector<ResultSet::DataType>& types) {
+    names_ = names;
+    types_ = types;
+
+    if (format_ == Format::FILE) {
+        write_bytes(MAGIC.data(), MAGIC.size());
+        write_bytes("\0\0", 2);
+    }
+
+    FlatBufferBuilder builder;
+    uint32_t schema = create_schema(builder, names_, types_);
+
+    builder.start_table();
+    builder.add_offset(2, schema);
+    builder.add_scalar<int64_t>(3, 0);
+    builder.add_scalar<int16_t>(0, METADATA_VERSION_V5);
+    builder.add_scalar<uint8_t>(1, HEADER_SCHEMA);
+
+    write_message(builder.finish(builder.end_table()), {});
+    schema_written_ = true;
+}
+
+void ArrowWriter::write_batches(std::vector<ColumnBatch>& batches) {
+    for (auto& batch : batches) {
+        write_batch(batch);
+    }
+
+    batches.clear();
+}
+
+void ArrowWriter::write_batch(ColumnBatch& batch) {
+    using DataType = ResultSet::DataType;
+
+    for (size_t i = 0; i < batch.columns.size(); i++) {
+        auto& column = batch.columns[i];
+
+        // A column with only NULL values takes the type of the schema, and
+        // an INTEGER column is promoted to a FLOAT one
+        if (column.type != types_[i] && (column.type == DataType::NULL_VALUE
+                || (column.type == DataType::INTEGER && types_[i] == DataType::FLOAT))) {
+            column.store(types_[i], batch.rows);
+        }
+
+        if (column.type != types_[i]) {
+            throw std::logic_error("Columns don't match the Arrow schema");
+        }
+    }
+
+    std::vector<uint8_t> nodes;
+    std::vector<uint8_t> buffers;
+    body_.clear();
+
+    auto add_buffer = [&](const void* data, size_t size) {
+        append(buffers, static_cast<int64_t>(body_.size()));
+        append(buffers, static_cast<int64_t>(size));
+
+        auto bytes = static_cast<const uint8_t*>(data);
+        body_.insert(body_.end(), bytes, bytes + size);
+        body_.resize(body_.size() + (ALIGNMENT - body_.size() % ALIGNMENT) % ALIGNMENT);
+    };
+
+    for (const auto& column : batch.columns) {
+        size_t valid = 0;
+
+        for (auto byte : column.validity) {
+            valid += std::bitset<8>(byte).count();
+        }
+
+        auto nulls = static_cast<int64_t>(batch.rows - valid);
+        append(nodes, static_cast<int64_t>(batch.rows));
+        append(nodes, nulls);
+
+        // A Null column has no buffers
+        if (column.type == ResultSet::DataType::NULL_VALUE) {
+            continue;
+        }
+
+        // The validity bitmap can be omitted when there are no NULL values
+        add_buffer(column.validity.data(), nulls > 0 ? column.validity.size() : 0);
+
+        switch (column.type) {
+            case ResultSet::DataType::INTEGER:
+                add_buffer(column.integers.data(), column.integers.size() * sizeof(int64_t));
+                break;
+            case ResultSet::DataType::FLOAT:
+                add_buffer(column.reals.data(), column.reals.size() * sizeof(double));
+                break;
+            default:
+                add_buffer(column.offsets.data(), column.offsets.size() * sizeof(int64_t));
+                add_buffer(column.data.data(), column.data.size());
+                break;
+        }
+    }
+
+    FlatBufferBuilder builder;
+    uint32_t node_vector = builder.create_structs(nodes, batch.columns.size());
+    uint32_t buffer_vector = builder.create_structs(buffers, buffers.size() / 16);
+
+    builder.start_table();
+    builder.add_scalar<int64_t>(0, static_cast<int64_t>(batch.rows));
+    builder.add_offset(1, node_vector);
+    builder.add_offset(2, buffer_vector);
+    uint32_t record_batch = builder.end_table();
+
+    builder.start_table();
+    builder.add_scalar<int64_t>(3, static_cast<int64_t>(body_.size()));
+    builder.add_offset(2, record_batch);
+    builder.add_scalar<int16_t>(0, METADATA_VERSION_V5);
+    builder.add_scalar<uint8_t>(1, HEADER_RECORD_BATCH);
+
+    blocks_.push_back(write_message(builder.finish(builder.end_table()), body_));
+}
+
+ArrowWriter::Block ArrowWriter::write_message(const std::vector<uint8_t>& metadata,
+        const std::vector<uint8_t>& body) {
+
+    // The body must start on an 8-byte boundary
+    size_t padding = (ALIGNMENT - metadata.size() % ALIGNMENT) % ALIGNMENT;
+    auto size = static_cast<int32_t>(metadata.size() + padding);
+    Block block{position_, size + 8, static_cast<int64_t>(body.size())};
+    const uint8_t zeros[ALIGNMENT] = {};
+
+    write_bytes(&CONTINUATION, sizeof(CONTINUATION));
+    write_bytes(&size, sizeof(size));
+    write_bytes(metadata.data(), metadata.size());
+    write_bytes(zeros, padding);
+    write_bytes(body.data(), body.size());
+
+    return block;
+}
+
+void ArrowWriter::write_bytes(const void* data, size_t size) {
+    output_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+    if (!output_) {
+        throw std::logic_error("Failed to write Arrow output");
+    }
+
+    position_ += static_cast<int64_t>(size);
+}
+
+} // namespace cppdbc
@@ -0,0 +1,454 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cppdbc/prefetching_resultset.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace cppdbc {
+
+PrefetchingResultSet::PrefetchingResultSet(ResultSet& source, size_t rows, size_t depth) :
+        source_{source},
+        rows_{rows} {
+
+    if (rows == 0) {
+        throw std::invalid_argument("Invalid number of rows per batch");
+    }
+
+    // One batch is consumed while the others are produced
+    if (depth < 2) {
+        throw std::invalid_argument("Invalid depth of prefetching ring");
+    }
+
+    metadata_ = source_.metadata();
+    ring_.resize(depth);
+    producer_ = std::thread(&PrefetchingResultSet::produce, this);
+
+    try {
+        next_batch();
+    } catch (...) {
+        stop_ = true;
+        producer_.join();
+        throw;
+    }
+}
+
+PrefetchingResultSet::~PrefetchingResultSet() {
+    stop_.store(true);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+
+    condition_.notify_all();
+    producer_.join();
+}
+
+bool PrefetchingResultSet::pending() const noexcept {
+    return batch_ != nullptr;
+}
+
+bool PrefetchingResultSet::next() {
+    if (batch_ == nullptr) {
+        return false;
+    }
+
+    if (++row_ < batch_->rows) {
+        return true;
+    }
+
+    return next_batch();
+}
+
+void PrefetchingResultSet::set_type_checking(bool enabled) noexcept {
+    type_checking_ = enabled;
+}
+
+ResultSet::DataType PrefetchingResultSet::data_type(column_t column) const {
+    const auto& values = *this->column(column, DataType::NULL_VALUE);
+
+    if (!values.valid(row_)) {
+        return DataType::NULL_VALUE;
+    }
+
+    return values.has_integer(row_) ? DataType::INTEGER : values.type;
+}
+
+bool PrefetchingResultSet::is_null(column_t column) const {
+    return data_type(column) == DataType::NULL_VALUE;
+}
+
+uint8_t PrefetchingResultSet::uint8(column_t column) const {
+    return static_cast<uint8_t>(integer(column));
+}
+
+uint16_t PrefetchingResultSet::uint16(column_t column) const {
+    return static_cast<uint16_t>(integer(column));
+}
+
+uint32_t PrefetchingResultSet::uint32(column_t column) const {
+    return static_cast<uint32_t>(integer(column));
+}
+
+uint64_t PrefetchingResultSet::uint64(column_t column) const {
+    return static_cast<uint64_t>(integer(column));
+}
+
+int8_t PrefetchingResultSet::int8(column_t column) const {
+    return static_cast<int8_t>(integer(column));
+}
+
+int16_t PrefetchingResultSet::int16(column_t column) const {
+    return static_cast<int16_t>(integer(column));
+}
+
+int32_t PrefetchingResultSet::int32(column_t column) const {
+    return static_cast<int32_t>(integer(column));
+}
+
+int64_t PrefetchingResultSet::int64(column_t column) const {
+    return integer(column);
+}
+
+bool PrefetchingResultSet::boolean(column_t column) const {
+    return integer(column) != 0;
+}
+
+float PrefetchingResultSet::flt(column_t column) const {
+    return static_cast<float>(real(column));
+}
+
+double PrefetchingResultSet::dbl(column_t column) const {
+    return real(column);
+}
+
+std::string PrefetchingResultSet::str(column_t column) const {
+    return std::string(text_view(column));
+}
+
+std::unique_ptr<const void*> PrefetchingResultSet::blob(column_t column, size_t* size) const {
+    if (!size) {
+        throw std::invalid_argument("Size's pointer cannot be null");
+    }
+
+    BlobView value = blob_view(column);
+    *size = value.size();
+
+    if (value.empty()) {
+        return nullptr;
+    }
+
+    return std::make_unique<const void*>(value.data());
+}
+
+std::string_view PrefetchingResultSet::text_view(column_t column) const {
+    const auto* values = this->column(column, DataType::TEXT);
+    return values != nullptr ? values->text(row_) : std::string_view();
+}
+
+BlobView PrefetchingResultSet::blob_view(column_t column) const {
+    const auto* values = this->column(column, DataType::BLOB);
+    return values != nullptr ? values->blob(row_) : BlobView();
+}
+
+size_t PrefetchingResultSet::fetch_batch(ColumnBatch& batch, size_t rows) {
+    batch.clear();
+
+    if (batch_ == nullptr || rows == 0) {
+        return 0;
+    }
+
+    size_t columns = batch_->columns.size();
+
+    if (batch.columns.size() != columns || batch.source != batch_->source) {
+        batch.columns.assign(columns, ColumnBatch::Column());
+        batch.source = batch_->source;
+
+        for (size_t i = 0; i < columns; i++) {
+            batch.columns[i].type = batch_->columns[i].type;
+            batch.columns[i].clear();
+        }
+    }
+
+    while (batch_ != nullptr && batch.rows < rows) {
+        size_t row = batch.rows;
+
+        for (size_t i = 0; i < columns; i++) {
+            auto& target = batch.columns[i];
+            const auto& values = batch_->columns[i];
+            bool valid = values.valid(row_);
+
+            // The batches can have different types, so the target is promoted
+            if (valid) {
+                target.store(values.type, row);
+            }
+
+            if (row % 8 == 0) {
+                target.validity.push_back(0);
+            }
+
+            target.validity.back() |= static_cast<uint8_t>(valid ? 1U << (row % 8) : 0U);
+
+            switch (target.type) {
+                case DataType::INTEGER:
+                    target.integers.push_back(valid ? values.integers[row_] : 0);
+                    break;
+
+                case DataType::FLOAT:
+                    if (values.has_integer(row_)) {
+                        target.append_integer(values.integers[row_], row);
+                    } else {
+                        target.append_real(valid ? values.reals[row_] : 0.0, row);
+                    }
+                    break;
+
+                case DataType::NULL_VALUE:
+                    break;
+
+                default: {
+                    BlobView value;
+
+                    if (valid) {
+                        value = values.blob(row_);
+                    }
+
+                    target.data.insert(target.data.end(), value.begin(), value.end());
+                    target.offsets.push_back(static_cast<int64_t>(target.data.size()));
+                    break;
+                }
+            }
+        }
+
+        batch.rows++;
+        next();
+    }
+
+    return batch.rows;
+}
+
+void PrefetchingResultSet::read(const Field* fields, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        const Field& field = fields[i];
+        auto column = static_cast<column_t>(i);
+
+        if (field.nullable() && is_null(column)) {
+            field.set_null();
+            continue;
+        }
+
+        switch (field.type()) {
+            case Field::Type::BOOL:
+                field.get<bool>() = boolean(column);
+                break;
+            case Field::Type::INT8:
+                field.get<int8_t>() = int8(column);
+                break;
+            case Field::Type::INT16:
+                field.get<int16_t>() = int16(column);
+                break;
+            case Field::Type::INT32:
+                field.get<int32_t>() = int32(column);
+                break;
+            case Field::Type::INT64:
+                field.get<int64_t>() = int64(column);
+                break;
+            case Field::Type::UINT8:
+                field.get<uint8_t>() = uint8(column);
+                break;
+            case Field::Type::UINT16:
+                field.get<uint16_t>() = uint16(column);
+                break;
+            case Field::Type::UINT32:
+                field.get<uint32_t>() = uint32(column);
+                break;
+            case Field::Type::UINT64:
+                field.get<uint64_t>() = uint64(column);
+                break;
+            case Field::Type::FLOAT:
+                field.get<float>() = flt(column);
+                break;
+            case Field::Type::DOUBLE:
+                field.get<double>() = dbl(column);
+                break;
+            case Field::Type::TEXT: {
+                std::string_view text = text_view(column);
+                field.get<std::string>().assign(text.data(), text.size());
+                break;
+            }
+            case Field::Type::BLOB: {
+                BlobView blob = blob_view(column);
+                field.get<std::vector<std::byte>>().assign(blob.begin(), blob.end());
+                break;
+            }
+        }
+    }
+}
+
+std::shared_ptr<const ResultSetMetadata> PrefetchingResultSet::metadata() const {
+    return metadata_;
+}
+
+void PrefetchingResultSet::produce() {
+    size_t depth = ring_.size();
+
+    try {
+        while (true) {
+            size_t head = head_.load(std::memory_order_relaxed);
+
+            // Wait for a free batch in the ring
+            if (head - tail_.load(std::memory_order_acquire) == depth) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [&] {
+                    return stop_.load() || head - tail_.load(std::memory_order_acquire) < depth;
+                });
+            }
+
+            if (stop_.load()) {
+                break;
+            }
+
+            if (source_.fetch_batch(ring_[head % depth], rows_) == 0) {
+                break;
+            }
+
+            head_.store(head + 1, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+
+            condition_.notify_all();
+        }
+    } catch (...) {
+        error_ = std::current_exception();
+    }
+
+    done_.store(true, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+
+    condition_.notify_all();
+}
+
+bool PrefetchingResultSet::next_batch() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+
+    if (batch_ != nullptr) {
+        batch_ = nullptr;
+        tail_.store(++tail, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+
+        condition_.notify_all();
+    }
+
+    // The producer publishes its last batch before finishing, so the batches
+    // are checked after it's known whether it has finished
+    auto ready = [&] {
+        bool done = done_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) != tail || done;
+    };
+
+    if (!ready()) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, ready);
+    }
+
+    if (head_.load(std::memory_order_acquire) == tail) {
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+
+        return false;
+    }
+
+    batch_ = &ring_[tail % ring_.size()];
+    row_ = 0;
+
+    return true;
+}
+
+const ColumnBatch::Column* PrefetchingResultSet::column(column_t column, DataType type) const {
+    if (batch_ == nullptr) {
+        throw std::logic_error("Result set has no row");
+    }
+
+    if (column >= batch_->columns.size()) {
+        throw std::invalid_argument("Invalid column");
+    }
+
+    const auto& values = batch_->columns[column];
+
+    if (type == DataType::NULL_VALUE) {
+        return &values;
+    }
+
+    // NULL is read as an empty BLOB, and as zero or empty when unchecked
+    if (!values.valid(row_)) {
+        if (type_checking_ && type != DataType::BLOB) {
+            throw std::invalid_argument("Column doesn't have the expected data type");
+        }
+
+        return nullptr;
+    }
+
+    // Unchecked numbers are converted, and texts and BLOBs are both bytes
+    auto numeric = [](DataType t) { return t == DataType::INTEGER || t == DataType::FLOAT; };
+    DataType actual = values.has_integer(row_) ? DataType::INTEGER : values.type;
+    bool convertible = numeric(type) == numeric(actual);
+
+    if (actual != type && (type_checking_ || !convertible)) {
+        throw std::invalid_argument("Column doesn't have the expected data type");
+    }
+
+    return &values;
+}
+
+int64_t PrefetchingResultSet::integer(column_t column) const {
+    const auto* values = this->column(column, DataType::INTEGER);
+
+    if (values == nullptr) {
+        return 0;
+    }
+
+    // The INTEGER values of FLOAT columns are kept without loss
+    return values->has_integer(row_) ? values->integers[row_] :
+            static_cast<int64_t>(values->reals[row_]);
+}
+
+double PrefetchingResultSet::real(column_t column) const {
+    const auto* values = this->column(column, DataType::FLOAT);
+
+    if (values == nullptr) {
+        return 0.0;
+    }
+
+    return values->type == DataType::INTEGER ? static_cast<double>(values->integers[row_]) :
+            values->reals[row_];
+}
+
+} // namespace cppdbc
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sqlite_blob_stream.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "cppdbc/sqlite/sqlite_database.hpp"
+
+namespace cppdbc {
+
+SQLiteBlobStream::SQLiteBlobStream(const std::shared_ptr<SQLiteDatabase>& database,
+        const std::string& table, const std::string& column, int64_t rowid,
+        bool writable) :
+        writable_{writable},
+        database_{database} {
+
+    if (database_ == nullptr || database_->sqlite_ == nullptr) {
+        throw std::invalid_argument("Cannot open blob for invalid database");
+    }
+
+    int result = sqlite3_blob_open(database_->sqlite_, "main", table.c_str(),
+            column.c_str(), rowid, writable ? 1 : 0, &blob_);
+
+    if (result != SQLITE_OK) {
+        // SQLite may return a handler even when it fails to open the BLOB
+        sqlite3_blob_close(blob_);
+        throw std::invalid_argument("Failed to open blob from " + table + "." + column);
+    }
+
+    size_ = static_cast<size_t>(sqlite3_blob_bytes(blob_));
+}
+
+SQLiteBlobStream::SQLiteBlobStream(SQLiteBlobStream&& other) noexcept:
+        writable_{other.writable_},
+        size_{other.size_},
+        blob_{other.blob_},
+        database_{std::move(other.database_)} {
+
+    other.size_ = 0;
+    other.blob_ = nullptr;
+}
+
+SQLiteBlobStream::~SQLiteBlobStream() {
+    if (blob_ != nullptr) {
+        sqlite3_blob_close(blob_);
+    }
+}
+
+SQLiteBlobStream& SQLiteBlobStream::operator=(SQLiteBlobStream&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (blob_ != nullptr) {
+        sqlite3_blob_close(blob_);
+    }
+
+    writable_ = other.writable_;
+    size_ = other.size_;
+    blob_ = other.blob_;
+    database_ = std::move(other.database_);
+
+    other.size_ = 0;
+    other.blob_ = nullptr;
+
+    return *this;
+}
+
+size_t SQLiteBlobStream::size() const noexcept {
+    return size_;
+}
+
+void SQLiteBlobStream::read(size_t offset, void* data, size_t size) {
+    check_chunk(offset, size);
+
+    int result = sqlite3_blob_read(blob_, data, static_cast<int>(size),
+            static_cast<int>(offset));
+
+    if (result != SQLITE_OK) {
+        throw std::logic_error("Failed to read blob");
+    }
+}
+
+void SQLiteBlobStream::write(size_t offset, const void* data, size_t size) {
+    if (!writable_) {
+        throw std::logic_error("Cannot write read-only blob");
+    }
+
+    check_chunk(offset, size);
+
+    int result = sqlite3_blob_write(blob_, data, static_cast<int>(size),
+            static_cast<int>(offset));
+
+    if (result != SQLITE_OK) {
+        throw std::logic_error("Failed to write blob");
+    }
+}
+
+void SQLiteBlobStream::reopen(int64_t rowid) {
+    if (blob_ == nullptr) {
+        throw std::logic_error("Cannot reopen invalid blob");
+    }
+
+    int result = sqlite3_blob_reopen(blob_, rowid);
+
+    if (result != SQLITE_OK) {
+        // The handler is aborted and can't be read or written anymore
+        size_ = 0;
+        throw std::invalid_argument("Failed to reopen blob");
+    }
+
+    size_ = static_cast<size_t>(sqlite3_blob_bytes(blob_));
+}
+
+void SQLiteBlobStream::check_chunk(size_t offset, size_t size) const {
+    if (blob_ == nullptr) {
+        throw std::logic_error("Cannot access invalid blob");
+    }
+
+    if (offset > size_ || size > size_ - offset) {
+        throw std::invalid_argument("Chunk out of blob");
+    }
+}
+
+} // namespace cppdbc
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @brief SQLite BLOB stream.
+ * @file
+ */
+
+#ifndef SQLITE_BLOB_STREAM_HPP
+#define SQLITE_BLOB_STREAM_HPP
+
+#include <memory>
+#include <string>
+#include <sqlite3.h>
+
+#include "cppdbc/blob_stream.hpp"
+
+namespace cppdbc {
+
+// Forward declarations
+class SQLiteDatabase;
+
+/**
+ * @brief SQLite BLOB stream.
+ *
+ * A SQLite BLOB stream gives incremental access to a BLOB of a SQLite
+ * database.
+ */
+class SQLiteBlobStream : public BlobStream {
+public:
+    /**
+     * @brief Create SQLite BLOB stream.
+     *
+     * Constructor of the SQLite BLOB stream.
+     *
+     * @param[in] database SQLite database which the BLOB belongs to.
+     * @param[in] table Name of the table.
+     * @param[in] column Name of the column.
+     * @param[in] rowid Row ID of the row which the BLOB belongs to.
+     * @param[in] writable Indicates if the BLOB can be written.
+     *
+     * @throw std::invalid_argument in case of invalid database or failure to
+     * open the BLOB.
+     */
+    SQLiteBlobStream(const std::shared_ptr<SQLiteDatabase>& database,
+            const std::string& table, const std::string& column, int64_t rowid,
+            bool writable);
+
+    /**
+     * @brief Remove copy constructor.
+     *
+     * SQLite BLOB stream is not copyable.
+     */
+    SQLiteBlobStream(const SQLiteBlobStream&) = delete;
+
+    /**
+     * @brief Move constructor.
+     *
+     * Move constructor of the SQLite BLOB stream.
+     */
+    SQLiteBlobStream(SQLiteBlobStream&& other) noexcept;
+
+    /**
+     * @brief Destroy SQLite BLOB stream.
+     *
+     * Destructor of the SQLite BLOB stream.
+     */
+    ~SQLiteBlobStream() override;
+
+    /**
+     * @brief Remove copy assignment.
+     *
+     * SQLite BLOB stream is not copyable.
+     */
+    SQLiteBlobStream& operator=(const SQLiteBlobStream&) = delete;
+
+    /**
+     * @brief Move assignment.
+     *
+     * Move assignment of the SQLite BLOB stream.
+     */
+    SQLiteBlobStream& operator=(SQLiteBlobStream&& other) noexcept;
+
+    /**
+     * @brief Get size.
+     *
+     * Get the number of bytes of the BLOB.
+     *
+     * @return Size of the BLOB.
+     */
+    [[nodiscard]] size_t size() const noexcept override;
+
+    /**
+     * @brief Read from BLOB.
+     *
+     * Read a chunk of the BLOB starting at the given offset.
+     *
+     * @param[in] offset Offset, in bytes, from the beginning of the BLOB.
+     * @param[out] data Memory location where the chunk shall be stored.
+     * @param[in] size Number of bytes to be read.
+     *
+     * @throw std::invalid_argument in case the chunk is out of the BLOB.
+     * @throw std::logic_error in case of failure to read the BLOB.
+     */
+    void read(size_t offset, void* data, size_t size) override;
+
+    /**
+     * @brief Write to BLOB.
+     *
+     * Write a chunk to the BLOB starting at the given offset.
+     *
+     * @param[in] offset Offset, in bytes, from the beginning of the BLOB.
+     * @param[in] data Memory location of the chunk to be written.
+     * @param[in] size Number of bytes to be written.
+     *
+     * @throw std::invalid_argument in case the chunk is out of the BLOB.
+     * @throw std::logic_error in case of failure to write the BLOB or the
+     * stream is read-only.
+     */
+    void write(size_t offset, const void* data, size_t size) override;
+
+    /**
+     * @brief Reopen SQLite BLOB stream.
+     *
+     * Move the stream to the BLOB of another row of the same table and
+     * column, which is faster than opening a new stream.
+     *
+     * @param[in] rowid Row ID of the row which the BLOB belongs to.
+     *
+     * @throw std::invalid_argument in case of invalid row.
+     * @throw std::logic_error in case of invalid stream.
+     */
+    void reopen(int64_t rowid) override;
+
+private:
+    /**
+     * @brief Check chunk.
+     *
+     * Check if the chunk is within the BLOB.
+     *
+     * @param[in] offset Offset, in bytes, from the beginning of the BLOB.
+     * @param[in] size Number of bytes of the chunk.
+     *
+     * @throw std::invalid_argument in case the chunk is out of the BLOB.
+     * @throw std::logic_error in case of invalid stream.
+     */
+    void check_chunk(size_t offset, size_t size) const;
+
+    /**
+     * @brief Indicates if the BLOB can be written.
+     */
+    bool writable_ = false;
+
+    /**
+     * @brief Number of bytes of the BLOB.
+     */
+    size_t size_ = 0;
+
+    /**
+     * @brief SQLite BLOB handler.
+     */
+    sqlite3_blob* blob_ = nullptr;
+
+    /**
+     * @brief SQLite database object.
+     */
+    std::shared_ptr<SQLiteDatabase> database_;
+};
+
+} // namespace cppdbc
+
+#endif // SQLITE_BLOB_STREAM_HPP
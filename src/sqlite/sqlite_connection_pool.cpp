@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cppdbc/sqlite/sqlite_connection_pool.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppdbc {
+
+struct SQLiteConnectionPool::Shared {
+    mutable std::mutex mutex;
+    std::condition_variable released;
+    std::vector<std::shared_ptr<SQLiteDatabase>> connections;
+    std::vector<std::thread::id> owners;
+    std::vector<size_t> idle;
+    WaitStats stats;
+};
+
+SQLiteConnectionPool::Lease::Lease(std::shared_ptr<Shared> shared, size_t index) noexcept :
+        shared_{std::move(shared)},
+        index_{index} {}
+
+SQLiteConnectionPool::Lease::Lease(Lease&& other) noexcept :
+        shared_{std::move(other.shared_)},
+        index_{other.index_} {}
+
+SQLiteConnectionPool::Lease::~Lease() {
+    release();
+}
+
+SQLiteConnectionPool::Lease& SQLiteConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        shared_ = std::move(other.shared_);
+        index_ = other.index_;
+    }
+
+    return *this;
+}
+
+SQLiteConnectionPool::Lease::operator bool() const noexcept {
+    return shared_ != nullptr;
+}
+
+SQLiteDatabase& SQLiteConnectionPool::Lease::operator*() const {
+    if (shared_ == nullptr) {
+        throw std::logic_error("Cannot access released lease");
+    }
+
+    return *shared_->connections[index_];
+}
+
+SQLiteDatabase* SQLiteConnectionPool::Lease::operator->() const {
+    return &**this;
+}
+
+void SQLiteConnectionPool::Lease::release() noexcept {
+    if (shared_ == nullptr) {
+        return;
+    }
+
+    // The statements still in use must not touch the connection once it's
+    // leased to another thread
+    shared_->connections[index_]->invalidate_statements();
+
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->idle.push_back(index_);
+    }
+
+    shared_->released.notify_one();
+    shared_.reset();
+}
+
+SQLiteConnectionPool::SQLiteConnectionPool(const std::string& filename, size_t size,
+        SQLiteDatabase::SQLiteMode mode) :
+        SQLiteConnectionPool(filename, size,
+                SQLiteDatabase::OpenOptions{mode, SQLiteDatabase::ThreadingMode::SERIALIZED}) {}
+
+SQLiteConnectionPool::SQLiteConnectionPool(const std::string& filename, size_t size,
+        const SQLiteDatabase::OpenOptions& options, const SQLiteTuning& tuning) :
+        shared_{std::make_shared<Shared>()} {
+
+    auto mode = options.mode;
+    auto settings = tuning;
+
+    if (!settings.busy_timeout) {
+        settings.busy_timeout = DEFAULT_BUSY_TIMEOUT;
+    }
+
+    if (size == 0) {
+        throw std::invalid_argument("Invalid size of connection pool");
+    }
+
+    if (mode == SQLiteDatabase::SQLiteMode::IN_MEMORY) {
+        throw std::invalid_argument("Connection pool requires a database file");
+    }
+
+    shared_->connections.reserve(size);
+    shared_->owners.resize(size);
+
+    for (size_t i = 0; i < size; i++) {
+        auto connection = std::make_shared<SQLiteDatabase>(filename, options);
+
+        try {
+            connection->tune(settings);
+
+            // The journal mode is persistent, so it's set only once
+            if (i == 0 && mode != SQLiteDatabase::SQLiteMode::READ_ONLY &&
+                    settings.journal_mode == SQLiteTuning::JournalMode::DEFAULT) {
+                connection->execute_script("PRAGMA journal_mode = WAL;");
+            }
+        } catch (const std::exception& e) {
+            throw std::invalid_argument(std::string("Failed to configure connection: ") +
+                    e.what());
+        }
+
+        shared_->connections.push_back(std::move(connection));
+        shared_->idle.push_back(size - 1 - i);
+    }
+}
+
+SQLiteConnectionPool::Lease SQLiteConnectionPool::acquire() {
+    return std::move(*acquire(std::nullopt));
+}
+
+std::optional<SQLiteConnectionPool::Lease> SQLiteConnectionPool::try_acquire(
+        std::chrono::nanoseconds timeout) {
+
+    return acquire(std::optional<std::chrono::nanoseconds>(timeout));
+}
+
+size_t SQLiteConnectionPool::size() const noexcept {
+    return shared_->connections.size();
+}
+
+size_t SQLiteConnectionPool::idle() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->idle.size();
+}
+
+SQLiteConnectionPool::WaitStats SQLiteConnectionPool::wait_stats() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->stats;
+}
+
+std::optional<SQLiteConnectionPool::Lease> SQLiteConnectionPool::acquire(
+        std::optional<std::chrono::nanoseconds> timeout) {
+
+    auto start = std::chrono::steady_clock::now();
+    auto thread = std::this_thread::get_id();
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    auto& idle = shared_->idle;
+    auto& stats = shared_->stats;
+    bool waited = idle.empty();
+
+    if (waited) {
+        auto available = [&] { return !idle.empty(); };
+
+        if (!timeout) {
+            shared_->released.wait(lock, available);
+        } else if (!shared_->released.wait_for(lock, *timeout, available)) {
+            stats.waits++;
+            stats.timeouts++;
+            return std::nullopt;
+        }
+    }
+
+    // The connection last leased by this thread is preferred. Otherwise, the
+    // connection released most recently is taken
+    auto connection = std::find_if(idle.rbegin(), idle.rend(), [&](size_t index) {
+        return shared_->owners[index] == thread;
+    });
+
+    if (connection != idle.rend()) {
+        stats.affine++;
+        std::iter_swap(connection, idle.rbegin());
+    }
+
+    size_t index = idle.back();
+    idle.pop_back();
+    shared_->owners[index] = thread;
+    stats.acquisitions++;
+
+    if (waited) {
+        auto wait = std::chrono::steady_clock::now() - start;
+        stats.waits++;
+        stats.total_wait += wait;
+        stats.max_wait = std::max<std::chrono::nanoseconds>(stats.max_wait, wait);
+    }
+
+    return Lease(shared_, index);
+}
+
+} // namespace cppdbc
@@ -22,8 +22,12 @@
 
 #include "cppdbc/sqlite/sqlite_database.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <stdexcept>
 
+#include "sqlite_blob_stream.hpp"
 #include "sqlite_statement.hpp"
 #include "sqlite_transaction.hpp"
 
@@ -32,8 +36,11 @@ namespace cppdbc {
 SQLiteDatabase::SQLiteDatabase(const std::string& filename) :
         SQLiteDatabase(filename, SQLiteMode::READ_ONLY) {}
 
-SQLiteDatabase::SQLiteDatabase(const std::string& filename, SQLiteMode mode) {
-    int32_t flags = parse_sqlite_mode(mode);
+SQLiteDatabase::SQLiteDatabase(const std::string& filename, SQLiteMode mode) :
+        SQLiteDatabase(filename, OpenOptions{mode}) {}
+
+SQLiteDatabase::SQLiteDatabase(const std::string& filename, const OpenOptions& options) {
+    int32_t flags = parse_open_options(options);
 
     int result = sqlite3_open_v2(filename.c_str(), &sqlite_, flags, nullptr);
 
@@ -43,13 +50,34 @@ SQLiteDatabase::SQLiteDatabase(const std::string& filename, SQLiteMode mode) {
     }
 }
 
+SQLiteDatabase::SQLiteDatabase(const std::string& filename, SQLiteMode mode,
+        const SQLiteTuning& tuning) :
+        SQLiteDatabase(filename, OpenOptions{mode}, tuning) {}
+
+SQLiteDatabase::SQLiteDatabase(const std::string& filename, const OpenOptions& options,
+        const SQLiteTuning& tuning) :
+        SQLiteDatabase(filename, options) {
+
+    tune(tuning);
+}
+
 SQLiteDatabase::SQLiteDatabase(SQLiteDatabase&& other) noexcept:
-        sqlite_{other.sqlite_} {
+        sqlite_{other.sqlite_},
+        cache_capacity_{other.cache_capacity_},
+        cache_stats_{other.cache_stats_},
+        cache_{std::move(other.cache_)},
+        cache_index_{std::move(other.cache_index_)} {
 
+    // The statements in use refer to the moved database, so they can't be
+    // moved with the connection
+    other.invalidate_statements();
     other.sqlite_ = nullptr;
+    other.cache_index_.clear();
 }
 
 SQLiteDatabase::~SQLiteDatabase() {
+    clear_statement_cache();
+
     if (sqlite_ != nullptr) {
         sqlite3_close(sqlite_);
     }
@@ -60,12 +88,22 @@ SQLiteDatabase& SQLiteDatabase::operator=(SQLiteDatabase&& other) noexcept {
         return *this;
     }
 
+    invalidate_statements();
+    clear_statement_cache();
+
     if (sqlite_ != nullptr) {
         sqlite3_close(sqlite_);
     }
 
+    other.invalidate_statements();
     sqlite_ = other.sqlite_;
+    cache_capacity_ = other.cache_capacity_;
+    cache_stats_ = other.cache_stats_;
+    cache_ = std::move(other.cache_);
+    cache_index_ = std::move(other.cache_index_);
+
     other.sqlite_ = nullptr;
+    other.cache_index_.clear();
 
     return *this;
 }
@@ -79,13 +117,96 @@ std::shared_ptr<Statement> SQLiteDatabase::create_statement(const std::string& s
         throw std::logic_error("Cannot create statement for invalid database");
     }
 
-    return std::make_shared<SQLiteStatement>(shared_from_this(), sql);
+    std::string query;
+    std::unique_ptr<SQLiteStatement> statement;
+    auto entry = cache_index_.find(sql);
+
+    if (cache_capacity_ == 0) {
+        statement = std::make_unique<SQLiteStatement>(shared_from_this(), sql);
+    } else if (entry != cache_index_.end()) {
+        auto cached = entry->second;
+        cache_index_.erase(entry);
+
+        query = std::move(cached->first);
+        statement = std::move(cached->second);
+        cache_.erase(cached);
+
+        statement->database_ = shared_from_this();
+        cache_stats_.hits++;
+    } else {
+        query = sql;
+        statement = std::make_unique<SQLiteStatement>(shared_from_this(), sql,
+                SQLITE_PREPARE_PERSISTENT);
+
+        cache_stats_.misses++;
+    }
+
+    statements_.push_back(statement.get());
+
+    // The statement is released once the last reference to it, including
+    // its result sets, has been released
+    return std::shared_ptr<SQLiteStatement>(statement.release(),
+            [query = std::move(query)](SQLiteStatement* released) mutable {
+                std::unique_ptr<SQLiteStatement> owned{released};
+                auto database = std::move(owned->database_);
+
+                if (database) {
+                    database->release_statement(std::move(query), std::move(owned));
+                }
+            });
 }
 
 std::shared_ptr<Transaction> SQLiteDatabase::create_transaction() {
     return std::make_shared<SQLiteTransaction>(shared_from_this());
 }
 
+void SQLiteDatabase::execute_script(std::string_view script) {
+    if (this->sqlite_ == nullptr) {
+        throw std::logic_error("Cannot execute script for invalid database");
+    }
+
+    const char* position = script.data();
+    const char* end = script.data() + script.size();
+    size_t index = 0;
+
+    while (position != end) {
+        if (std::isspace(static_cast<unsigned char>(*position))) {
+            position++;
+            continue;
+        }
+
+        sqlite3_stmt* statement = nullptr;
+        const char* tail = nullptr;
+
+        int result = sqlite3_prepare_v2(sqlite_, position, static_cast<int>(end - position),
+                &statement, &tail);
+
+        if (result == SQLITE_OK && statement != nullptr) {
+            do {
+                result = sqlite3_step(statement);
+            } while (result == SQLITE_ROW);
+
+            sqlite3_finalize(statement);
+        }
+
+        if (result != SQLITE_OK && result != SQLITE_DONE) {
+            throw script_error(index, static_cast<size_t>(position - script.data()),
+                    sqlite3_errmsg(sqlite_));
+        }
+
+        // Comments and empty statements are not counted as statements
+        if (statement != nullptr) {
+            index++;
+        }
+
+        if (tail == nullptr || tail <= position) {
+            break;
+        }
+
+        position = tail;
+    }
+}
+
 int32_t SQLiteDatabase::parse_sqlite_mode(SQLiteDatabase::SQLiteMode mode) {
     switch (mode) {
         default:
@@ -105,14 +226,222 @@ int32_t SQLiteDatabase::parse_sqlite_mode(SQLiteDatabase::SQLiteMode mode) {
     }
 }
 
+int32_t SQLiteDatabase::parse_open_options(const OpenOptions& options) {
+    auto flags = static_cast<uint32_t>(parse_sqlite_mode(options.mode));
+
+    switch (options.threading) {
+        case ThreadingMode::MULTI_THREAD:
+            flags |= static_cast<uint32_t>(SQLITE_OPEN_NOMUTEX);
+            break;
+
+        case ThreadingMode::SERIALIZED:
+            flags |= static_cast<uint32_t>(SQLITE_OPEN_FULLMUTEX);
+            break;
+
+        default:
+            break;
+    }
+
+    switch (options.cache) {
+        case CacheMode::PRIVATE:
+            flags |= static_cast<uint32_t>(SQLITE_OPEN_PRIVATECACHE);
+            break;
+
+        case CacheMode::SHARED:
+            flags |= static_cast<uint32_t>(SQLITE_OPEN_SHAREDCACHE);
+            break;
+
+        default:
+            break;
+    }
+
+    if (options.uri) {
+        flags |= static_cast<uint32_t>(SQLITE_OPEN_URI);
+    }
+
+    return static_cast<int32_t>(flags);
+}
+
 bool SQLiteDatabase::has_table(const std::string& tableName) {
     auto statement = create_statement(
             "SELECT count(*) FROM sqlite_master WHERE type='table' AND name=?");
 
     statement->bind(tableName, 0);
-    auto result = statement->execute();
 
-    return result->uint8(0) == 1;
+    return statement->query_scalar<int64_t>().value_or(0) == 1;
+}
+
+std::shared_ptr<BlobStream> SQLiteDatabase::open_blob(const std::string& table,
+        const std::string& column, int64_t rowid, bool writable) {
+
+    if (this->sqlite_ == nullptr) {
+        throw std::logic_error("Cannot open blob for invalid database");
+    }
+
+    return std::make_shared<SQLiteBlobStream>(shared_from_this(), table, column, rowid,
+            writable);
+}
+
+void SQLiteDatabase::tune(const SQLiteTuning& tuning) {
+    if (this->sqlite_ == nullptr) {
+        throw std::logic_error("Cannot tune invalid database");
+    }
+
+    // The lookaside memory can only be configured while it's not in use, and
+    // SQLite has no way to read its configuration back
+    if (tuning.lookaside) {
+        int result = sqlite3_db_config(sqlite_, SQLITE_DBCONFIG_LOOKASIDE, nullptr,
+                static_cast<int>(tuning.lookaside->slot_size),
+                static_cast<int>(tuning.lookaside->slots));
+
+        if (result != SQLITE_OK) {
+            throw std::invalid_argument("Failed to tune database: lookaside is in use");
+        }
+    }
+
+    if (tuning.busy_timeout) {
+        apply_pragma("busy_timeout", std::to_string(tuning.busy_timeout->count()));
+    }
+
+    // The page size must be set before the database is switched to WAL mode
+    if (tuning.page_size) {
+        apply_pragma("page_size", std::to_string(*tuning.page_size));
+    }
+
+    if (tuning.journal_mode != SQLiteTuning::JournalMode::DEFAULT) {
+        static constexpr std::array<const char*, 7> JOURNAL_MODES = {
+                "", "delete", "truncate", "persist", "memory", "wal", "off"};
+
+        apply_pragma("journal_mode", JOURNAL_MODES[static_cast<size_t>(tuning.journal_mode)]);
+    }
+
+    // The synchronous mode and the temporary store are read back as numbers
+    if (tuning.synchronous != SQLiteTuning::Synchronous::DEFAULT) {
+        apply_pragma("synchronous", std::to_string(static_cast<int>(tuning.synchronous) - 1));
+    }
+
+    if (tuning.temp_store != SQLiteTuning::TempStore::DEFAULT) {
+        apply_pragma("temp_store", std::to_string(static_cast<int>(tuning.temp_store)));
+    }
+
+    if (tuning.cache_size) {
+        apply_pragma("cache_size", std::to_string(*tuning.cache_size));
+    }
+
+    if (tuning.mmap_size) {
+        apply_pragma("mmap_size", std::to_string(*tuning.mmap_size));
+    }
+}
+
+void SQLiteDatabase::invalidate_statements() noexcept {
+    if (statements_.empty()) {
+        return;
+    }
+
+    // The statements may hold the last references to the database
+    auto self = shared_from_this();
+
+    for (auto* statement : statements_) {
+        statement->invalidate();
+    }
+
+    statements_.clear();
+}
+
+void SQLiteDatabase::set_statement_cache_capacity(size_t capacity) {
+    cache_capacity_ = capacity;
+    evict_statements();
+}
+
+size_t SQLiteDatabase::statement_cache_capacity() const noexcept {
+    return cache_capacity_;
+}
+
+SQLiteDatabase::StatementCacheStats SQLiteDatabase::statement_cache_stats() const noexcept {
+    return cache_stats_;
+}
+
+void SQLiteDatabase::apply_pragma(const std::string& name, const std::string& value) {
+    try {
+        execute_script("PRAGMA " + name + " = " + value + ";");
+    } catch (const std::exception& e) {
+        throw std::invalid_argument("Failed to tune database: " + std::string(e.what()));
+    }
+
+    auto current = query_pragma(name);
+
+    if (current != value) {
+        throw std::invalid_argument("Failed to tune database: " + name + " is " + current +
+                " instead of " + value);
+    }
+}
+
+std::string SQLiteDatabase::query_pragma(const std::string& name) {
+    std::string sql = "PRAGMA " + name + ";";
+    sqlite3_stmt* statement = nullptr;
+
+    int result = sqlite3_prepare_v2(sqlite_, sql.c_str(), static_cast<int>(sql.size()),
+            &statement, nullptr);
+
+    if (result != SQLITE_OK || statement == nullptr) {
+        sqlite3_finalize(statement);
+        throw std::invalid_argument("Failed to query pragma " + name);
+    }
+
+    std::string value;
+
+    if (sqlite3_step(statement) == SQLITE_ROW) {
+        const auto* text = sqlite3_column_text(statement, 0);
+
+        if (text != nullptr) {
+            value = reinterpret_cast<const char*>(text);
+        }
+    }
+
+    sqlite3_finalize(statement);
+    return value;
+}
+
+void SQLiteDatabase::release_statement(std::string query,
+        std::unique_ptr<SQLiteStatement> statement) {
+
+    auto used = std::find(statements_.begin(), statements_.end(), statement.get());
+
+    if (used != statements_.end()) {
+        *used = statements_.back();
+        statements_.pop_back();
+    }
+
+    if (query.empty() || cache_capacity_ == 0 || sqlite_ == nullptr ||
+            statement->statement_ == nullptr) {
+        return;
+    }
+
+    // Only one idle statement is kept for each query
+    if (cache_index_.find(query) != cache_index_.end()) {
+        return;
+    }
+
+    statement->reset();
+    statement->clear_bindings();
+
+    cache_.emplace_front(std::move(query), std::move(statement));
+    cache_index_.emplace(cache_.front().first, cache_.begin());
+
+    evict_statements();
+}
+
+void SQLiteDatabase::evict_statements() {
+    while (cache_.size() > cache_capacity_) {
+        cache_index_.erase(cache_.back().first);
+        cache_.pop_back();
+        cache_stats_.evictions++;
+    }
+}
+
+void SQLiteDatabase::clear_statement_cache() noexcept {
+    cache_index_.clear();
+    cache_.clear();
 }
 
 } // namespace cppdbc
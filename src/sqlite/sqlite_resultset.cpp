@@ -22,21 +22,35 @@
 
 #include "sqlite_resultset.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
+#include "cppdbc/column_batch.hpp"
+
 #include "sqlite_statement.hpp"
 
 namespace cppdbc {
 
 SQLiteResultSet::SQLiteResultSet(const std::shared_ptr<SQLiteStatement>& statement) :
-        statement_{statement} {
+        statement_{statement.get()},
+        owner_{statement} {
 
     if (statement_ == nullptr) {
         throw std::invalid_argument("Cannot create result set for invalid statement");
     }
+
+    generation_ = statement_->generation_;
 }
 
+SQLiteResultSet::SQLiteResultSet(SQLiteStatement& statement) noexcept :
+        generation_{statement.generation_},
+        statement_{&statement} {}
+
 bool SQLiteResultSet::next() {
+    if (stale()) {
+        pending_ = false;
+    }
+
     if (!pending_) {
         return false;
     }
@@ -46,6 +60,7 @@ bool SQLiteResultSet::next() {
     }
 
     int result = sqlite3_step(statement_->statement_);
+    column_types_.fill(0);
 
     if (result == SQLITE_DONE) {
         pending_ = false;
@@ -54,10 +69,12 @@ bool SQLiteResultSet::next() {
     return pending_;
 }
 
-ResultSet::DataType SQLiteResultSet::data_type(column_t column) const {
-    int result = sqlite3_column_type(statement_->statement_, column);
+void SQLiteResultSet::set_type_checking(bool enabled) noexcept {
+    type_checking_ = enabled;
+}
 
-    switch (result) {
+ResultSet::DataType SQLiteResultSet::data_type(column_t column) const {
+    switch (column_type(column)) {
         default:
         case SQLITE_INTEGER:
             return DataType::INTEGER;
@@ -66,11 +83,20 @@ ResultSet::DataType SQLiteResultSet::data_type(column_t column) const {
         case SQLITE_TEXT:
             return DataType::TEXT;
         case SQLITE_BLOB:
-        case SQLITE_NULL:
             return DataType::BLOB;
+        case SQLITE_NULL:
+            return DataType::NULL_VALUE;
     }
 }
 
+bool SQLiteResultSet::is_null(column_t column) const {
+    if (stale()) {
+        throw std::logic_error("Result set is no longer valid as its statement was reset");
+    }
+
+    return column_type(column) == SQLITE_NULL;
+}
+
 uint8_t SQLiteResultSet::uint8(column_t column) const {
     check_data_type(column, DataType::INTEGER);
     return static_cast<uint8_t>(sqlite3_column_int(statement_->statement_, column));
@@ -150,10 +176,275 @@ std::unique_ptr<const void*> SQLiteResultSet::blob(column_t column, size_t* size
     return std::make_unique<const void*>(blob);
 }
 
+std::string_view SQLiteResultSet::text_view(column_t column) const {
+    check_data_type(column, DataType::TEXT);
+
+    // The size must be got after the text, as getting the text may convert it
+    auto text = reinterpret_cast<const char*>(sqlite3_column_text(statement_->statement_, column));
+    auto size = static_cast<size_t>(sqlite3_column_bytes(statement_->statement_, column));
+
+    if (text == nullptr) {
+        return {};
+    }
+
+    return {text, size};
+}
+
+BlobView SQLiteResultSet::blob_view(column_t column) const {
+    check_data_type(column, DataType::BLOB);
+
+    auto blob = static_cast<const std::byte*>(sqlite3_column_blob(statement_->statement_, column));
+    auto size = static_cast<size_t>(sqlite3_column_bytes(statement_->statement_, column));
+
+    if (blob == nullptr) {
+        return {};
+    }
+
+    return {blob, size};
+}
+
+size_t SQLiteResultSet::fetch_batch(ColumnBatch& batch, size_t rows) {
+    if (stale()) {
+        pending_ = false;
+    }
+
+    batch.clear();
+
+    if (!pending_ || rows == 0) {
+        return 0;
+    }
+
+    sqlite3_stmt* statement = statement_->statement_;
+
+    if (statement == nullptr) {
+        throw std::logic_error("Cannot fetch batch for invalid statement");
+    }
+
+    auto columns = static_cast<size_t>(sqlite3_column_count(statement));
+
+    // The generation identifies the execution of the statement, so the data
+    // types are only kept for the batches of the same result
+    if (batch.columns.size() != columns || batch.source != generation_) {
+        batch.columns.assign(columns, ColumnBatch::Column());
+        batch.source = generation_;
+
+        for (size_t i = 0; i < columns; i++) {
+            batch.columns[i].type = batch_data_type(static_cast<column_t>(i));
+            batch.columns[i].clear();
+        }
+    }
+
+    for (auto& column : batch.columns) {
+        column.validity.reserve((rows + 7) / 8);
+
+        if (column.type == DataType::INTEGER) {
+            column.integers.reserve(rows);
+        } else if (column.type == DataType::FLOAT) {
+            column.reals.reserve(rows);
+        } else if (column.type != DataType::NULL_VALUE) {
+            column.offsets.reserve(rows + 1);
+        }
+    }
+
+    while (batch.rows < rows) {
+        size_t row = batch.rows;
+
+        for (size_t i = 0; i < columns; i++) {
+            auto& column = batch.columns[i];
+            int index = static_cast<int>(i);
+            DataType type = data_type(static_cast<column_t>(i));
+            bool valid = type != DataType::NULL_VALUE;
+
+            // The column is promoted, instead of converting the value with loss
+            column.store(type, row);
+
+            if (row % 8 == 0) {
+                column.validity.push_back(0);
+            }
+
+            column.validity.back() |= static_cast<uint8_t>(valid ? 1U << (row % 8) : 0U);
+
+            switch (column.type) {
+                case DataType::INTEGER:
+                    column.integers.push_back(valid ? sqlite3_column_int64(statement, index) : 0);
+                    break;
+
+                case DataType::FLOAT:
+                    if (type == DataType::INTEGER) {
+                        column.append_integer(sqlite3_column_int64(statement, index), row);
+                    } else {
+                        column.append_real(valid ? sqlite3_column_double(statement, index) : 0.0, row);
+                    }
+                    break;
+
+                case DataType::NULL_VALUE:
+                    break;
+
+                default: {
+                    // The size must be got after the value, as getting the
+                    // value may convert it
+                    const void* value = nullptr;
+
+                    if (valid) {
+                        value = column.type == DataType::TEXT ?
+                                static_cast<const void*>(sqlite3_column_text(statement, index)) :
+                                sqlite3_column_blob(statement, index);
+                    }
+
+                    auto size = value != nullptr ?
+                            static_cast<size_t>(sqlite3_column_bytes(statement, index)) : 0;
+                    auto offset = column.data.size();
+
+                    column.data.resize(offset + size);
+
+                    if (size > 0) {
+                        std::memcpy(column.data.data() + offset, value, size);
+                    }
+
+                    column.offsets.push_back(static_cast<int64_t>(offset + size));
+                    break;
+                }
+            }
+        }
+
+        batch.rows++;
+        column_types_.fill(0);
+
+        int result = sqlite3_step(statement);
+
+        if (result == SQLITE_DONE) {
+            pending_ = false;
+            break;
+        }
+
+        if (result != SQLITE_ROW) {
+            pending_ = false;
+            throw std::logic_error("Failed to fetch batch");
+        }
+    }
+
+    return batch.rows;
+}
+
+std::shared_ptr<const ResultSetMetadata> SQLiteResultSet::metadata() const {
+    return statement_->metadata();
+}
+
+void SQLiteResultSet::read(const Field* fields, size_t count) const {
+    sqlite3_stmt* statement = statement_->statement_;
+
+    for (size_t i = 0; i < count; i++) {
+        const Field& field = fields[i];
+        auto column = static_cast<column_t>(i);
+        int index = static_cast<int>(i);
+
+        if (field.nullable() && is_null(column)) {
+            field.set_null();
+            continue;
+        }
+
+        switch (field.type()) {
+            case Field::Type::BOOL:
+                check_data_type(column, DataType::INTEGER);
+                field.get<bool>() = sqlite3_column_int(statement, index) != 0;
+                break;
+            case Field::Type::INT8:
+                check_data_type(column, DataType::INTEGER);
+                field.get<int8_t>() = static_cast<int8_t>(sqlite3_column_int(statement, index));
+                break;
+            case Field::Type::INT16:
+                check_data_type(column, DataType::INTEGER);
+                field.get<int16_t>() = static_cast<int16_t>(sqlite3_column_int(statement, index));
+                break;
+            case Field::Type::INT32:
+                check_data_type(column, DataType::INTEGER);
+                field.get<int32_t>() = sqlite3_column_int(statement, index);
+                break;
+            case Field::Type::INT64:
+                check_data_type(column, DataType::INTEGER);
+                field.get<int64_t>() = sqlite3_column_int64(statement, index);
+                break;
+            case Field::Type::UINT8:
+                check_data_type(column, DataType::INTEGER);
+                field.get<uint8_t>() = static_cast<uint8_t>(sqlite3_column_int(statement, index));
+                break;
+            case Field::Type::UINT16:
+                check_data_type(column, DataType::INTEGER);
+                field.get<uint16_t>() = static_cast<uint16_t>(sqlite3_column_int(statement, index));
+                break;
+            case Field::Type::UINT32:
+                check_data_type(column, DataType::INTEGER);
+                field.get<uint32_t>() = static_cast<uint32_t>(sqlite3_column_int(statement, index));
+                break;
+            case Field::Type::UINT64:
+                check_data_type(column, DataType::INTEGER);
+                field.get<uint64_t>() = static_cast<uint64_t>(sqlite3_column_int64(statement, index));
+                break;
+            case Field::Type::FLOAT:
+                check_data_type(column, DataType::FLOAT);
+                field.get<float>() = static_cast<float>(sqlite3_column_double(statement, index));
+                break;
+            case Field::Type::DOUBLE:
+                check_data_type(column, DataType::FLOAT);
+                field.get<double>() = sqlite3_column_double(statement, index);
+                break;
+            case Field::Type::TEXT: {
+                std::string_view text = text_view(column);
+                field.get<std::string>().assign(text.data(), text.size());
+                break;
+            }
+            case Field::Type::BLOB: {
+                BlobView blob = blob_view(column);
+                field.get<std::vector<std::byte>>().assign(blob.begin(), blob.end());
+                break;
+            }
+        }
+    }
+}
+
 void SQLiteResultSet::check_data_type(column_t column, ResultSet::DataType type) const {
-    if (data_type(column) != type) {
+    if (stale()) {
+        throw std::logic_error("Result set is no longer valid as its statement was reset");
+    }
+
+    if (!type_checking_) {
+        return;
+    }
+
+    // NULL is still read as an empty BLOB
+    DataType actual = data_type(column);
+
+    if (actual != type && !(actual == DataType::NULL_VALUE && type == DataType::BLOB)) {
         throw std::invalid_argument("Column doesn't have the expected data type");
     }
 }
 
+bool SQLiteResultSet::stale() const noexcept {
+    return generation_ != statement_->generation_;
+}
+
+ResultSet::DataType SQLiteResultSet::batch_data_type(column_t column) const {
+    if (column_type(column) != SQLITE_NULL) {
+        return data_type(column);
+    }
+
+    // Affinity of the declared type, as defined by SQLite
+    const char* declared = sqlite3_column_decltype(statement_->statement_, column);
+    return ColumnBatch::data_type(declared != nullptr ? declared : "");
+}
+
+int SQLiteResultSet::column_type(column_t column) const {
+    if (column >= CACHED_COLUMN_TYPES) {
+        return sqlite3_column_type(statement_->statement_, column);
+    }
+
+    // The type is got once per row, before any conversion made by SQLite
+    if (column_types_[column] == 0) {
+        column_types_[column] = static_cast<uint8_t>(
+                sqlite3_column_type(statement_->statement_, column));
+    }
+
+    return column_types_[column];
+}
+
 } // namespace cppdbc
@@ -25,6 +25,7 @@
  * @file
  */
 
+#include <array>
 #include <memory>
 #include <string>
 
@@ -56,6 +57,17 @@ public:
      */
     explicit SQLiteResultSet(const std::shared_ptr<SQLiteStatement>& statement);
 
+    /**
+     * @brief Create SQLite result set owned by statement.
+     *
+     * Constructor of the SQLite result set which doesn't keep a reference to
+     * its statement. It's used by the statement to keep a result set for
+     * cursors without allocating memory.
+     *
+     * @param[in] statement SQLite statement to get the results.
+     */
+    explicit SQLiteResultSet(SQLiteStatement& statement) noexcept;
+
     /**
     * @brief Next result set.
     *
@@ -67,6 +79,18 @@ public:
     */
     bool next() override;
 
+    /**
+     * @brief Set type checking.
+     *
+     * Enable or disable checking the data type of a column before getting
+     * its value. Type checking is enabled by default. When it's disabled,
+     * the value is converted by SQLite to the requested type, which is only
+     * safe when the schema of the result is trusted.
+     *
+     * @param[in] enabled Indicates if the data types shall be checked.
+     */
+    void set_type_checking(bool enabled) noexcept override;
+
     /**
     * @brief Get data type.
     *
@@ -80,6 +104,19 @@ public:
     */
     DataType data_type(column_t column) const override;
 
+    /**
+     * @brief Check if value is NULL.
+     *
+     * Check if the value of a given column of the result set is NULL.
+     *
+     * @param[in] column Column to check.
+     *
+     * @retval true - value is NULL.
+     * @retval false - value is not NULL.
+     * @throw std::logic_error in case of the statement was reset.
+     */
+    bool is_null(column_t column) const override;
+
     /**
      * @brief Get unsigned integer (8-bits).
      *
@@ -259,6 +296,84 @@ public:
      */
     std::unique_ptr<const void*> blob(column_t column, size_t* size) const override;
 
+    /**
+     * @brief Get text view.
+     *
+     * Get text value from a given column of the result set without copying
+     * it. The text is valid until the result set moves to the next result.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the text got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get text.
+     */
+    std::string_view text_view(column_t column) const override;
+
+    /**
+     * @brief Get BLOB view.
+     *
+     * Get BLOB value from a given column of the result set without copying
+     * it. The BLOB is valid until the result set moves to the next result.
+     *
+     * @param[in] column Column to get value.
+     *
+     * @return View of the BLOB got from column.
+     * @throw std::invalid_argument in case of invalid column.
+     * @throw std::logic_error in case of failure to get BLOB.
+     */
+    BlobView blob_view(column_t column) const override;
+
+    /**
+     * @brief Fetch batch.
+     *
+     * Fetch up to a given number of rows, starting from the current one, into
+     * the column-major buffers of a batch. Afterwards, the result set is
+     * positioned on the first row not fetched.
+     *
+     * The data type of each column is given by the first fetched row when
+     * the batch doesn't have the same number of columns as the result set.
+     * A NULL value in the first row takes the data type from the affinity of
+     * the declared type of the column, until a value which isn't NULL is
+     * fetched. Otherwise, the data types of the batch are kept, and a column
+     * is promoted when its values have different storage classes.
+     *
+     * @param[out] batch Batch to store the rows.
+     * @param[in] rows Maximum number of rows to fetch.
+     *
+     * @return Number of fetched rows, zero when the result set finished.
+     * @throw std::invalid_argument in case of the values of a column can't be
+     * stored in the batch without loss.
+     * @throw std::logic_error in case of failure to fetch the rows.
+     */
+    size_t fetch_batch(ColumnBatch& batch, size_t rows) override;
+
+    /**
+     * @brief Read fields.
+     *
+     * Read the first columns of the current row into the given fields, in
+     * order. All fields are read at once, calling SQLite directly for each
+     * column.
+     *
+     * @param[out] fields Fields which shall receive the columns.
+     * @param[in] count Number of fields.
+     *
+     * @throw std::invalid_argument in case a column doesn't have the expected
+     * data type.
+     * @throw std::logic_error in case of failure to read the columns.
+     */
+    void read(const Field* fields, size_t count) const override;
+
+    /**
+     * @brief Get metadata.
+     *
+     * Get the metadata of the columns of the result set.
+     *
+     * @return Metadata of the result set.
+     * @throw std::logic_error in case of invalid statement.
+     */
+    [[nodiscard]] std::shared_ptr<const ResultSetMetadata> metadata() const override;
+
 private:
     /**
      * @brief Check data type.
@@ -271,9 +386,51 @@ private:
      *
      * @throw std::invalid_argument in case of the column doesn't have the
      * expected data type.
+     * @throw std::logic_error in case of the statement has been reset.
      */
     void check_data_type(column_t column, DataType type) const;
 
+    /**
+     * @brief Check if the result set is stale.
+     *
+     * A result set becomes stale once the statement which created it has been
+     * reset, as the statement no longer points to the results of this result
+     * set.
+     *
+     * @retval true - result set is stale.
+     * @retval false - result set is still valid.
+     */
+    [[nodiscard]] bool stale() const noexcept;
+
+    /**
+     * @brief Get SQLite column type.
+     *
+     * Get the SQLite type of a given column of the current row. The types of
+     * the first columns are got from SQLite once per row and cached.
+     *
+     * @param[in] column Column to get the type.
+     *
+     * @return SQLite type of the column.
+     */
+    [[nodiscard]] int column_type(column_t column) const;
+
+    /**
+     * @brief Get batch data type.
+     *
+     * Get the data type which a column of the current row shall have in a
+     * column batch.
+     *
+     * @param[in] column Column to get the data type.
+     *
+     * @return Data type of the column.
+     */
+    [[nodiscard]] DataType batch_data_type(column_t column) const;
+
+    /**
+     * @brief Number of columns whose types are cached.
+     */
+    static constexpr size_t CACHED_COLUMN_TYPES = 16;
+
     /**
      * @brief Indicates if the result set is pending.
      *
@@ -282,10 +439,34 @@ private:
      */
     bool pending_ = true;
 
+    /**
+     * @brief Indicates if the data types are checked.
+     */
+    bool type_checking_ = true;
+
+    /**
+     * @brief Generation of the statement when the result set was created.
+     */
+    uint64_t generation_ = 0;
+
+    /**
+     * @brief SQLite types of the columns of the current row.
+     *
+     * @note A type equals to zero has not been got from SQLite yet.
+     */
+    mutable std::array<uint8_t, CACHED_COLUMN_TYPES> column_types_{};
+
     /**
      * @brief SQLite statement to get the next results sets.
      */
-    std::shared_ptr<SQLiteStatement> statement_;
+    SQLiteStatement* statement_ = nullptr;
+
+    /**
+     * @brief Reference to the SQLite statement.
+     *
+     * @note It's null when the result set is owned by the statement.
+     */
+    std::shared_ptr<SQLiteStatement> owner_;
 };
 
 } // namespace cppdbc
@@ -22,15 +22,36 @@
 
 #include "sqlite_statement.hpp"
 
+#include <atomic>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 
 #include "cppdbc/sqlite/sqlite_database.hpp"
 #include "sqlite_resultset.hpp"
 
 namespace cppdbc {
 
+namespace {
+
+/**
+ * @brief Get next generation.
+ *
+ * The generations are unique among all statements, so a generation also
+ * identifies the statement whose execution it belongs to.
+ *
+ * @return New generation.
+ */
+uint64_t next_generation() noexcept {
+    static std::atomic<uint64_t> generation{0};
+    return ++generation;
+}
+
+} // namespace
+
 SQLiteStatement::SQLiteStatement(const std::shared_ptr<SQLiteDatabase>& database,
         const std::string& query) :
+        generation_{next_generation()},
         database_{database} {
 
     if (database_ == nullptr) {
@@ -42,11 +63,34 @@ SQLiteStatement::SQLiteStatement(const std::shared_ptr<SQLiteDatabase>& database
             static_cast<int>(query.size()), &statement_, nullptr);
 
     check_sqlite_result(result, "Failed to create statement");
+    map_parameters();
+}
+
+SQLiteStatement::SQLiteStatement(const std::shared_ptr<SQLiteDatabase>& database,
+        const std::string& query, uint32_t flags) :
+        generation_{next_generation()},
+        database_{database} {
+
+    if (database_ == nullptr) {
+        throw std::invalid_argument(
+                "Cannot create statement for invalid database");
+    }
+
+    int result = sqlite3_prepare_v3(database_->sqlite_, query.c_str(),
+            static_cast<int>(query.size()), flags, &statement_, nullptr);
+
+    check_sqlite_result(result, "Failed to create statement");
+    map_parameters();
 }
 
 SQLiteStatement::SQLiteStatement(SQLiteStatement&& other) noexcept:
         pending_{other.pending_},
+        generation_{other.generation_},
         statement_{other.statement_},
+        parameters_{std::move(other.parameters_)},
+        parameter_count_{other.parameter_count_},
+        retained_{std::move(other.retained_)},
+        metadata_{std::move(other.metadata_)},
         database_{std::move(other.database_)} {
 
     other.pending_ = false;
@@ -70,7 +114,13 @@ SQLiteStatement& SQLiteStatement::operator=(cppdbc::SQLiteStatement&& other) noe
 
     database_ = std::move(other.database_);
     statement_ = other.statement_;
+    parameters_ = std::move(other.parameters_);
+    parameter_count_ = other.parameter_count_;
+    retained_ = std::move(other.retained_);
+    metadata_ = std::move(other.metadata_);
+    cursor_.reset();
     pending_ = other.pending_;
+    generation_ = other.generation_;
 
     other.statement_ = nullptr;
     other.pending_ = false;
@@ -83,27 +133,96 @@ bool SQLiteStatement::pending() const noexcept {
 }
 
 std::shared_ptr<ResultSet> SQLiteStatement::execute() {
-    if (!pending_) {
-        throw std::logic_error("Statement already executed");
+    if (!step()) {
+        return nullptr;
     }
 
+    return std::make_shared<SQLiteResultSet>(shared_from_this());
+}
+
+Cursor SQLiteStatement::query() {
+    if (!step()) {
+        return Cursor();
+    }
+
+    cursor_.emplace(*this);
+
+    // The cursor keeps the statement alive while it's used
+    return Cursor(std::shared_ptr<ResultSet>(shared_from_this(), &*cursor_));
+}
+
+void SQLiteStatement::reset() {
+    if (statement_ == nullptr) {
+        throw std::logic_error("Cannot reset invalid statement");
+    }
+
+    // The result of sqlite3_reset() only reports the error of the last step,
+    // which has already been reported by execute() or next()
+    sqlite3_reset(statement_);
+
+    pending_ = true;
+    generation_ = next_generation();
+}
+
+void SQLiteStatement::clear_bindings() {
+    if (statement_ == nullptr) {
+        throw std::logic_error("Cannot clear bindings of invalid statement");
+    }
+
+    sqlite3_clear_bindings(statement_);
+    retained_.clear();
+}
+
+BatchResult SQLiteStatement::execute_batch(size_t rows,
+        const std::function<void()>& bind_next_row) {
+
     if (statement_ == nullptr) {
         throw std::logic_error("Cannot execute invalid statement");
     }
 
-    int result = sqlite3_step(statement_);
-    pending_ = false;
+    sqlite3* sqlite = database_->sqlite_;
+    bool transaction = sqlite3_get_autocommit(sqlite) != 0;
 
-    switch (result) {
-        case SQLITE_ROW:
-            return std::make_shared<SQLiteResultSet>(shared_from_this());
-        case SQLITE_DONE:
-            return nullptr;
-        case SQLITE_CONSTRAINT:
-            throw constraint_violation();
-        default:
-            throw std::logic_error("Failed to execute SQLite statement");
+    if (transaction && sqlite3_exec(sqlite, "BEGIN TRANSACTION;", nullptr, nullptr,
+            nullptr) != SQLITE_OK) {
+        throw std::logic_error("Failed to begin batch transaction");
+    }
+
+    BatchResult batch;
+    batch.changes.reserve(rows);
+
+    sqlite3_reset(statement_);
+    generation_ = next_generation();
+
+    for (size_t row = 0; row < rows; row++) {
+        try {
+            bind_next_row();
+            step_to_completion();
+        } catch (...) {
+            batch.failed_row = row;
+            batch.error = std::current_exception();
+            break;
+        }
+
+        batch.changes.push_back(static_cast<uint64_t>(sqlite3_changes(sqlite)));
+        sqlite3_reset(statement_);
+    }
+
+    sqlite3_reset(statement_);
+    pending_ = true;
+
+    if (!transaction) {
+        return batch;
     }
+
+    if (!batch.succeeded()) {
+        sqlite3_exec(sqlite, "ROLLBACK;", nullptr, nullptr, nullptr);
+    } else if (sqlite3_exec(sqlite, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        sqlite3_exec(sqlite, "ROLLBACK;", nullptr, nullptr, nullptr);
+        throw std::logic_error("Failed to commit batch transaction");
+    }
+
+    return batch;
 }
 
 void SQLiteStatement::bind(uint8_t value, uint16_t index) {
@@ -159,6 +278,41 @@ void SQLiteStatement::bind(const std::string& value, uint16_t index) {
     check_sqlite_result(result, "Failed to bind string");
 }
 
+void SQLiteStatement::bind(std::string&& value, uint16_t index) {
+    Retained previous = retain(index, std::move(value));
+    const auto& retained = std::get<std::string>(retained_[index]);
+
+    int result = sqlite3_bind_text(statement_, index + 1, retained.c_str(),
+            static_cast<int>(retained.size()), SQLITE_STATIC);
+
+    check_bind_result(result, index, std::move(previous), "Failed to bind string");
+}
+
+void SQLiteStatement::bind(std::string_view value, uint16_t index, Lifetime lifetime) {
+    // A null pointer would be bound as NULL instead of an empty string
+    const char* data = value.data() != nullptr ? value.data() : "";
+
+    int result = sqlite3_bind_text(statement_, index + 1, data,
+            static_cast<int>(value.size()),
+            lifetime == Lifetime::STATIC ? SQLITE_STATIC : SQLITE_TRANSIENT);
+
+    check_sqlite_result(result, "Failed to bind string");
+}
+
+void SQLiteStatement::bind(std::shared_ptr<const std::string> value, uint16_t index) {
+    if (value == nullptr) {
+        throw std::invalid_argument("Cannot bind invalid string");
+    }
+
+    const std::string& text = *value;
+    Retained previous = retain(index, std::shared_ptr<const void>(std::move(value)));
+
+    int result = sqlite3_bind_text(statement_, index + 1, text.c_str(),
+            static_cast<int>(text.size()), SQLITE_STATIC);
+
+    check_bind_result(result, index, std::move(previous), "Failed to bind string");
+}
+
 void SQLiteStatement::bind(float value, uint16_t index) {
     int result = sqlite3_bind_double(statement_, index + 1, value);
     check_sqlite_result(result, "Failed to bind float");
@@ -170,16 +324,251 @@ void SQLiteStatement::bind(double value, uint16_t index) {
 }
 
 void SQLiteStatement::bind(const void* value, size_t size, uint16_t index) {
-    int result = sqlite3_bind_blob(statement_, index + 1, value,
-            static_cast<int>(size), nullptr);
+    bind(value, size, index, Lifetime::STATIC);
+}
+
+void SQLiteStatement::bind(const void* value, size_t size, uint16_t index, Lifetime lifetime) {
+    int result = sqlite3_bind_blob(statement_, index + 1, value, static_cast<int>(size),
+            lifetime == Lifetime::STATIC ? SQLITE_STATIC : SQLITE_TRANSIENT);
+
+    check_sqlite_result(result, "Failed to bind blob");
+}
+
+void SQLiteStatement::bind(std::vector<std::byte>&& value, uint16_t index) {
+    Retained previous = retain(index, std::move(value));
+    const auto& retained = std::get<std::vector<std::byte>>(retained_[index]);
+
+    int result = sqlite3_bind_blob(statement_, index + 1, retained.data(),
+            static_cast<int>(retained.size()), SQLITE_STATIC);
+
+    check_bind_result(result, index, std::move(previous), "Failed to bind blob");
+}
+
+void SQLiteStatement::bind(std::unique_ptr<std::byte[]>&& value, size_t size, uint16_t index) {
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Blob is too large to be bound");
+    }
+
+    // SQLite calls the destructor even when the binding fails
+    int result = sqlite3_bind_blob(statement_, index + 1, value.release(),
+            static_cast<int>(size), delete_blob);
+
+    check_sqlite_result(result, "Failed to bind blob");
+}
+
+void SQLiteStatement::bind(std::shared_ptr<const std::vector<std::byte>> value, uint16_t index) {
+    if (value == nullptr) {
+        throw std::invalid_argument("Cannot bind invalid blob");
+    }
+
+    const std::vector<std::byte>& blob = *value;
+    Retained previous = retain(index, std::shared_ptr<const void>(std::move(value)));
+
+    int result = sqlite3_bind_blob(statement_, index + 1, blob.data(),
+            static_cast<int>(blob.size()), SQLITE_STATIC);
+
+    check_bind_result(result, index, std::move(previous), "Failed to bind blob");
+}
+
+void SQLiteStatement::bind_zeroblob(uint64_t size, uint16_t index) {
+    int result = sqlite3_bind_zeroblob64(statement_, index + 1, size);
 
     check_sqlite_result(result, "Failed to bind blob");
 }
 
-void SQLiteStatement::check_sqlite_result(int result, const std::string& message) {
+void SQLiteStatement::bind(std::nullopt_t, uint16_t index) {
+    int result = sqlite3_bind_null(statement_, index + 1);
+    check_sqlite_result(result, "Failed to bind null");
+}
+
+void SQLiteStatement::bind_parameters(const Parameter* parameters, size_t count,
+        uint16_t index) {
+
+    for (size_t i = 0; i < count; i++) {
+        const Parameter& parameter = parameters[i];
+        int column = static_cast<int>(index + i + 1);
+        int result;
+
+        switch (parameter.type()) {
+            default:
+            case Parameter::Type::INTEGER:
+                result = sqlite3_bind_int64(statement_, column, parameter.integer());
+                break;
+            case Parameter::Type::FLOAT:
+                result = sqlite3_bind_double(statement_, column, parameter.real());
+                break;
+            case Parameter::Type::TEXT:
+                result = sqlite3_bind_text(statement_, column,
+                        static_cast<const char*>(parameter_data(parameter)),
+                        static_cast<int>(parameter.size()), SQLITE_STATIC);
+                break;
+            case Parameter::Type::BLOB:
+                result = sqlite3_bind_blob(statement_, column, parameter_data(parameter),
+                        static_cast<int>(parameter.size()), SQLITE_STATIC);
+                break;
+            case Parameter::Type::NULL_VALUE:
+                result = sqlite3_bind_null(statement_, column);
+                break;
+        }
+
+        check_sqlite_result(result, "Failed to bind parameter");
+    }
+}
+
+uint16_t SQLiteStatement::parameter_index(std::string_view name) const {
+    auto parameter = parameters_.find(name);
+
+    if (parameter == parameters_.end()) {
+        throw std::invalid_argument("Unknown parameter name");
+    }
+
+    return parameter->second;
+}
+
+std::shared_ptr<const ResultSetMetadata> SQLiteStatement::metadata() const {
+    if (metadata_) {
+        return metadata_;
+    }
+
+    if (statement_ == nullptr) {
+        throw std::logic_error("Cannot get metadata for invalid statement");
+    }
+
+    // Expressions don't have declared type nor origin
+    auto text = [](const char* value) {
+        return std::string(value != nullptr ? value : "");
+    };
+
+    int count = sqlite3_column_count(statement_);
+    std::vector<ResultSetMetadata::Column> columns;
+    columns.reserve(count);
+
+    for (int i = 0; i < count; i++) {
+        // The origin is only known when SQLite has the column metadata
+#ifdef SQLITE_ENABLE_COLUMN_METADATA
+        std::string table = text(sqlite3_column_table_name(statement_, i));
+        std::string origin = text(sqlite3_column_origin_name(statement_, i));
+#else
+        std::string table;
+        std::string origin;
+#endif
+
+        columns.push_back({
+                text(sqlite3_column_name(statement_, i)),
+                text(sqlite3_column_decltype(statement_, i)),
+                std::move(table),
+                std::move(origin)});
+    }
+
+    metadata_ = std::make_shared<const ResultSetMetadata>(std::move(columns));
+
+    return metadata_;
+}
+
+SQLiteStatement::Retained SQLiteStatement::retain(uint16_t index, Retained value) {
+    if (index >= parameter_count_) {
+        throw std::invalid_argument("Invalid parameter index");
+    }
+
+    if (retained_.size() < parameter_count_) {
+        retained_.resize(parameter_count_);
+    }
+
+    return std::exchange(retained_[index], std::move(value));
+}
+
+void SQLiteStatement::check_bind_result(int result, uint16_t index, Retained&& previous,
+        const char* message) {
+
+    if (result != SQLITE_OK) {
+        retained_[index] = std::move(previous);
+    }
+
+    check_sqlite_result(result, message);
+}
+
+const void* SQLiteStatement::parameter_data(const Parameter& parameter) noexcept {
+    // A null pointer would be bound as NULL instead of an empty value
+    return parameter.data() != nullptr ? parameter.data() : "";
+}
+
+void SQLiteStatement::delete_blob(void* blob) {
+    delete[] static_cast<std::byte*>(blob);
+}
+
+void SQLiteStatement::check_sqlite_result(int result, const char* message) {
     if (result != SQLITE_OK) {
         throw std::invalid_argument(message);
     }
 }
 
+bool SQLiteStatement::step() {
+    if (statement_ == nullptr) {
+        throw std::logic_error("Cannot execute invalid statement");
+    }
+
+    if (!pending_) {
+        throw std::logic_error("Statement already executed");
+    }
+
+    int result = sqlite3_step(statement_);
+    pending_ = false;
+
+    switch (result) {
+        case SQLITE_ROW:
+            return true;
+        case SQLITE_DONE:
+            return false;
+        case SQLITE_CONSTRAINT:
+            throw constraint_violation();
+        default:
+            throw std::logic_error("Failed to execute SQLite statement");
+    }
+}
+
+void SQLiteStatement::step_to_completion() {
+    int result;
+
+    do {
+        result = sqlite3_step(statement_);
+    } while (result == SQLITE_ROW);
+
+    switch (result) {
+        case SQLITE_DONE:
+            return;
+        case SQLITE_CONSTRAINT:
+            throw constraint_violation();
+        default:
+            throw std::logic_error("Failed to execute SQLite statement");
+    }
+}
+
+void SQLiteStatement::invalidate() noexcept {
+    if (statement_ != nullptr) {
+        sqlite3_finalize(statement_);
+        statement_ = nullptr;
+    }
+
+    pending_ = false;
+    generation_ = next_generation();
+    database_.reset();
+}
+
+void SQLiteStatement::map_parameters() {
+    if (statement_ == nullptr) {
+        return;
+    }
+
+    int count = sqlite3_bind_parameter_count(statement_);
+    parameter_count_ = static_cast<uint16_t>(count);
+
+    for (int index = 1; index <= count; index++) {
+        const char* name = sqlite3_bind_parameter_name(statement_, index);
+
+        if (name != nullptr) {
+            parameters_.emplace(name, static_cast<uint16_t>(index - 1));
+        }
+    }
+}
+
 } // namespace cppdbc
@@ -29,10 +29,16 @@
 #define SQLITE_STATEMENT_HPP
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 #include <sqlite3.h>
 
 #include "cppdbc/statement.hpp"
+#include "sqlite_resultset.hpp"
 
 namespace cppdbc {
 
@@ -58,6 +64,22 @@ public:
      */
     SQLiteStatement(const std::shared_ptr<SQLiteDatabase>& database, const std::string& query);
 
+    /**
+     * @brief Create SQLite statement with prepare flags.
+     *
+     * Constructor of the SQLite statements which are prepared with the given
+     * SQLite prepare flags (e.g. SQLITE_PREPARE_PERSISTENT for statements
+     * which are kept for a long time).
+     *
+     * @param[in] database SQLite database which the statement will be executed.
+     * @param[in] query SQL query to be executed on database.
+     * @param[in] flags SQLite prepare flags.
+     *
+     * @throw std::invalid_argument in case of invalid database or query.
+     */
+    SQLiteStatement(const std::shared_ptr<SQLiteDatabase>& database, const std::string& query,
+            uint32_t flags);
+
     /**
      * @brief Remove copy constructor.
      *
@@ -98,7 +120,7 @@ public:
      *
      * Check if the SQLite statement is pending. When a statement is created it
      * shall be pending and can be executed only once. After that, it shall
-     * not be pending anymore.
+     * not be pending anymore until it is reset.
      *
      * @retval true - statement pending.
      * @retval false - statement is not pending.
@@ -120,6 +142,77 @@ public:
      */
     std::shared_ptr<ResultSet> execute() override;
 
+    /**
+     * @brief Query SQLite statement.
+     *
+     * Execute the SQLite statement and get a cursor to its result set. The
+     * result set is kept inside the statement, so no memory is allocated to
+     * query the statement. The cursor shares the ownership of the statement.
+     *
+     * @return Cursor positioned on the first row, or an empty cursor when
+     * there are no rows.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    Cursor query() override;
+
+    /**
+     * @brief Get metadata.
+     *
+     * Get the metadata of the results of the SQLite statement. The metadata
+     * is computed on the first call and shared afterwards.
+     *
+     * @return Metadata of the results.
+     * @throw std::logic_error in case of invalid statement.
+     */
+    [[nodiscard]] std::shared_ptr<const ResultSetMetadata> metadata() const override;
+
+    /**
+     * @brief Reset SQLite statement.
+     *
+     * Reset the SQLite statement back to its initial state, so it can be
+     * executed again without being prepared again. The bound values are kept,
+     * and any result set created by a previous execution becomes invalid.
+     *
+     * @throw std::logic_error in case of invalid statement.
+     */
+    void reset() override;
+
+    /**
+     * @brief Clear bindings.
+     *
+     * Clear all values bound to the SQLite statement. Every parameter of the
+     * statement is set back to NULL.
+     *
+     * @throw std::logic_error in case of invalid statement.
+     */
+    void clear_bindings() override;
+
+    using Statement::bind;
+    using Statement::execute_batch;
+
+    /**
+     * @brief Execute batch.
+     *
+     * Execute the SQLite statement a given number of times. Before each
+     * execution, the parameters of the next row are bound by a given
+     * function. The statement is reset after each row.
+     *
+     * All rows are executed within a single transaction, unless a transaction
+     * is already open. When a row fails, the execution stops and the
+     * transaction is rolled back.
+     *
+     * @param[in] rows Number of rows.
+     * @param[in] bind_next_row Function which binds the next row of
+     * parameters.
+     *
+     * @return Result of the batch.
+     * @throw std::logic_error in case of invalid statement or failure to
+     * begin or commit the transaction.
+     */
+    BatchResult execute_batch(size_t rows, const std::function<void()>& bind_next_row) override;
+
     /**
      * @brief Bind unsigned integer (8-bits).
      *
@@ -250,6 +343,51 @@ public:
      */
     void bind(const std::string& value, uint16_t index) override;
 
+    /**
+     * @brief Bind string.
+     *
+     * Bind string value to a given index of the statement, moving the string
+     * into the statement. The string is released once the value is no longer
+     * bound, without being copied.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    void bind(std::string&& value, uint16_t index) override;
+
+    /**
+     * @brief Bind string view.
+     *
+     * Bind string view to a given index of the statement. With a static
+     * lifetime, the string is bound with SQLITE_STATIC and it's not copied.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     * @param[in] lifetime Lifetime of the value.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    void bind(std::string_view value, uint16_t index, Lifetime lifetime) override;
+
+    /**
+     * @brief Bind shared string.
+     *
+     * Bind shared string to a given index of the statement. The statement
+     * shares the ownership of the string, without copying it, until the
+     * value is no longer bound.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of invalid string or failure to
+     * bind the value to column.
+     */
+    void bind(std::shared_ptr<const std::string> value, uint16_t index) override;
+
     /**
      * @brief Bind float.
      *
@@ -279,7 +417,9 @@ public:
     /**
      * @brief Bind BLOB.
      *
-     * Bind BLOB to a given index of the statement.
+     * Bind BLOB to a given index of the statement. The memory is not copied
+     * and must remain valid until the statement is executed and the value is
+     * no longer bound (rebound, cleared or the statement destroyed).
      *
      * @param[in] value Pointer to memory location to be bound.
      * @param[in] size Number of bytes of the bound memory.
@@ -290,6 +430,127 @@ public:
      */
     void bind(const void* value, size_t size, uint16_t index) override;
 
+    /**
+     * @brief Bind BLOB with lifetime.
+     *
+     * Bind BLOB to a given index of the statement. With a static lifetime,
+     * the memory is bound with SQLITE_STATIC and it's not copied. With a
+     * transient lifetime, the memory is copied.
+     *
+     * @param[in] value Pointer to memory location to be bound.
+     * @param[in] size Number of bytes of the bound memory.
+     * @param[in] index Index which the value shall be bound.
+     * @param[in] lifetime Lifetime of the value.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    void bind(const void* value, size_t size, uint16_t index, Lifetime lifetime) override;
+
+    /**
+     * @brief Bind BLOB.
+     *
+     * Bind BLOB to a given index of the statement, moving the vector into the
+     * statement. The vector is released once the value is no longer bound,
+     * without being copied.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    void bind(std::vector<std::byte>&& value, uint16_t index) override;
+
+    /**
+     * @brief Bind BLOB.
+     *
+     * Bind BLOB to a given index of the statement, transferring the ownership
+     * of the memory to SQLite, which releases it through its destructor
+     * callback once the value is no longer bound.
+     *
+     * @param[in] value Memory to be bound.
+     * @param[in] size Number of bytes of the bound memory.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column, or the BLOB is larger than SQLite supports (in which case the
+     * caller keeps the ownership of the memory).
+     */
+    void bind(std::unique_ptr<std::byte[]>&& value, size_t size, uint16_t index) override;
+
+    /**
+     * @brief Bind shared BLOB.
+     *
+     * Bind shared BLOB to a given index of the statement. The statement
+     * shares the ownership of the vector, without copying it, until the
+     * value is no longer bound.
+     *
+     * @param[in] value Value to be bound.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of invalid BLOB or failure to bind
+     * the value to column.
+     */
+    void bind(std::shared_ptr<const std::vector<std::byte>> value, uint16_t index) override;
+
+    /**
+     * @brief Bind zero-filled BLOB.
+     *
+     * Bind a BLOB filled with zeros to a given index of the statement,
+     * without allocating its memory. The BLOB can be written later in chunks
+     * through a BLOB stream.
+     *
+     * @param[in] size Number of bytes of the BLOB.
+     * @param[in] index Index which the value shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value to
+     * column.
+     */
+    void bind_zeroblob(uint64_t size, uint16_t index) override;
+
+    /**
+     * @brief Bind NULL.
+     *
+     * Bind NULL to a given index of the statement.
+     *
+     * @param[in] index Index which NULL shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind NULL to column.
+     */
+    void bind(std::nullopt_t, uint16_t index) override;
+
+    /**
+     * @brief Bind parameters.
+     *
+     * Bind many parameters at once to consecutive indexes of the statement,
+     * starting from a given index.
+     *
+     * @param[in] parameters Pointer to the parameters to be bound.
+     * @param[in] count Number of parameters.
+     * @param[in] index Index which the first parameter shall be bound.
+     *
+     * @throw std::invalid_argument in case of failure to bind any parameter.
+     *
+     * @note Text and BLOB parameters are bound with SQLITE_STATIC, so their
+     * memory isn't copied.
+     */
+    void bind_parameters(const Parameter* parameters, size_t count, uint16_t index) override;
+
+    /**
+     * @brief Get parameter index.
+     *
+     * Get the index of a named parameter (e.g. :name, @name or $name) of the
+     * statement. The names are mapped once, when the statement is prepared.
+     *
+     * @param[in] name Name of the parameter, including its prefix.
+     *
+     * @return Index of the parameter.
+     * @throw std::invalid_argument in case of the statement doesn't have a
+     * parameter with the given name.
+     */
+    [[nodiscard]] uint16_t parameter_index(std::string_view name) const override;
+
 private:
     /**
      * @brief SQLite result set is friend.
@@ -299,6 +560,14 @@ private:
      */
     friend class SQLiteResultSet;
 
+    /**
+     * @brief SQLite database is friend.
+     *
+     * Defining SQLite database as friend of SQLite statement, the database
+     * can keep the statement in its statement cache.
+     */
+    friend class SQLiteDatabase;
+
     /**
      * @brief Check SQLite result.
      *
@@ -311,7 +580,109 @@ private:
      * @throw std::invalid_argument in case of the result value is not
      * SQLITE_OK.
      */
-    static void check_sqlite_result(int result, const std::string& message);
+    static void check_sqlite_result(int result, const char* message);
+
+    /**
+     * @brief Step statement until completion.
+     *
+     * Step the SQLite statement until it has no more results.
+     *
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::logic_error in case of failure to execute the statement.
+     */
+    void step_to_completion();
+
+    /**
+     * @brief Step statement.
+     *
+     * Step the pending SQLite statement to its first result.
+     *
+     * @retval true - statement has a result.
+     * @retval false - statement has completed without results.
+     * @throw cppdbc::constraint_violation in case of the statement violates
+     * any constraint.
+     * @throw std::logic_error in case of the statement is not pending or
+     * failure to execute the statement.
+     */
+    bool step();
+
+    /**
+     * @brief Invalidate statement.
+     *
+     * Finalize the SQLite statement and detach it from its database, so it
+     * no longer touches the connection. Its result sets become stale, and
+     * using it afterwards fails.
+     */
+    void invalidate() noexcept;
+
+    /**
+     * @brief Map parameters.
+     *
+     * Map the name of each named parameter of the prepared statement to its
+     * index.
+     */
+    void map_parameters();
+
+    /**
+     * @brief Value retained by the statement.
+     *
+     * Value owned by the statement while it's bound to a parameter.
+     */
+    using Retained = std::variant<std::monostate, std::string, std::vector<std::byte>,
+            std::shared_ptr<const void>>;
+
+    /**
+     * @brief Retain value.
+     *
+     * Keep a value owned by the statement while it's bound to a given
+     * parameter.
+     *
+     * @param[in] index Index of the parameter.
+     * @param[in] value Value to be retained.
+     *
+     * @return Value previously retained for the parameter, which must be kept
+     * until the new value has been bound.
+     * @throw std::invalid_argument in case of invalid index.
+     */
+    Retained retain(uint16_t index, Retained value);
+
+    /**
+     * @brief Check result of binding retained value.
+     *
+     * When the binding fails, SQLite may still refer to the value previously
+     * retained for the parameter, so the previous value is retained again
+     * before the exception is thrown.
+     *
+     * @param[in] result Result of the binding.
+     * @param[in] index Index of the parameter.
+     * @param[in] previous Value previously retained for the parameter.
+     * @param[in] message Message of the exception.
+     *
+     * @throw std::invalid_argument in case of failure to bind the value.
+     */
+    void check_bind_result(int result, uint16_t index, Retained&& previous,
+            const char* message);
+
+    /**
+     * @brief Get parameter data.
+     *
+     * Get the memory of a text or BLOB parameter to be bound.
+     *
+     * @param[in] parameter Text or BLOB parameter.
+     *
+     * @return Pointer to the memory of the parameter, which is never null.
+     */
+    static const void* parameter_data(const Parameter& parameter) noexcept;
+
+    /**
+     * @brief Delete BLOB.
+     *
+     * Destructor callback of the BLOBs owned by SQLite.
+     *
+     * @param[in] blob Memory of the BLOB.
+     */
+    static void delete_blob(void* blob);
 
     /**
      * @brief Indicates if the statement has not completed.
@@ -320,11 +691,53 @@ private:
      */
     bool pending_ = true;
 
+    /**
+     * @brief Generation of the statement.
+     *
+     * The generation is renewed each time the statement is reset, and it's
+     * unique among all statements.
+     *
+     * @note A result set is only valid while the statement generation is the
+     * same as when the result set was created.
+     */
+    uint64_t generation_ = 0;
+
     /**
      * @brief SQLite statement handler.
      */
     sqlite3_stmt* statement_ = nullptr;
 
+    /**
+     * @brief Index of the named parameters.
+     *
+     * @note The names are owned by the SQLite statement handler.
+     */
+    std::unordered_map<std::string_view, uint16_t> parameters_;
+
+    /**
+     * @brief Number of parameters of the statement.
+     */
+    uint16_t parameter_count_ = 0;
+
+    /**
+     * @brief Values retained by the statement, by parameter index.
+     */
+    std::vector<Retained> retained_;
+
+    /**
+     * @brief Metadata of the results.
+     *
+     * @note It's created on the first use and shared by all result sets.
+     */
+    mutable std::shared_ptr<const ResultSetMetadata> metadata_;
+
+    /**
+     * @brief Result set of the cursors.
+     *
+     * @note It's created on the first query and reused afterwards.
+     */
+    std::optional<SQLiteResultSet> cursor_;
+
     /**
      * @brief SQLite database object.
      */
@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cppdbc/text_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace cppdbc {
+
+namespace {
+
+/**
+ * @brief Minimum size of the output buffer, which fits any number.
+ */
+constexpr size_t MIN_BUFFER_SIZE = 64;
+
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+constexpr uint64_t HIGHS = 0x8080808080808080ULL;
+
+// The scanning is done 8 bytes at a time (SWAR). The masks below are not
+// zero when any byte of the word matches, and then the bytes are checked one
+// by one to find the first match.
+
+constexpr uint64_t equal(uint64_t word, char c) {
+    uint64_t x = word ^ (ONES * static_cast<uint8_t>(c));
+    return (x - ONES) & ~x & HIGHS;
+}
+
+constexpr uint64_t less(uint64_t word, uint8_t n) {
+    return (word - ONES * n) & ~word & HIGHS;
+}
+
+/**
+ * @brief Characters which require the CSV field to be quoted.
+ */
+struct CsvSpecial {
+    char delimiter;
+
+    [[nodiscard]] uint64_t word(uint64_t w) const noexcept {
+        return equal(w, '"') | equal(w, delimiter) | equal(w, '\n') | equal(w, '\r');
+    }
+
+    [[nodiscard]] bool byte(char c) const noexcept {
+        return c == '"' || c == delimiter || c == '\n' || c == '\r';
+    }
+};
+
+/**
+ * @brief Characters which are doubled in quoted CSV fields.
+ */
+struct CsvQuote {
+    [[nodiscard]] static uint64_t word(uint64_t w) noexcept {
+        return equal(w, '"');
+    }
+
+    [[nodiscard]] static bool byte(char c) noexcept {
+        return c == '"';
+    }
+};
+
+/**
+ * @brief Characters which are escaped in JSON strings.
+ */
+struct JsonSpecial {
+    [[nodiscard]] static uint64_t word(uint64_t w) noexcept {
+        return equal(w, '"') | equal(w, '\\') | less(w, 0x20);
+    }
+
+    [[nodiscard]] static bool byte(char c) noexcept {
+        return c == '"' || c == '\\' || static_cast<uint8_t>(c) < 0x20;
+    }
+};
+
+/**
+ * @brief Find special character.
+ *
+ * @param[in] text Text to be scanned.
+ * @param[in] from Position to start the scanning.
+ * @param[in] special Special characters.
+ *
+ * @return Position of the first special character, or the size of the text
+ * when there's none.
+ */
+template<typename Special>
+size_t find(std::string_view text, size_t from, const Special& special) {
+    const char* data = text.data();
+    size_t i = from;
+
+    for (; i + sizeof(uint64_t) <= text.size(); i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+
+        if (special.word(word) != 0) {
+            break;
+        }
+    }
+
+    for (; i < text.size(); i++) {
+        if (special.byte(data[i])) {
+            return i;
+        }
+    }
+
+    return text.size();
+}
+
+/**
+ * @brief Escape JSON string.
+ *
+ * @param[in] text Text to be escaped, without quotes.
+ * @param[in] emit Function which receives the escaped text in pieces.
+ */
+template<typename Emit>
+void escape_json(std::string_view text, Emit&& emit) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    size_t start = 0;
+
+    for (size_t i = find(text, 0, JsonSpecial()); i < text.size();
+            i = find(text, start, JsonSpecial())) {
+
+        emit(text.substr(start, i - start));
+        auto c = static_cast<uint8_t>(text[i]);
+
+        switch (c) {
+            case '"':
+                emit("\\\"");
+                break;
+            case '\\':
+                emit("\\\\");
+                break;
+            case '\n':
+                emit("\\n");
+                break;
+            case '\r':
+                emit("\\r");
+                break;
+            case '\t':
+                emit("\\t");
+                break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4U], HEX[c & 0xFU]};
+                emit(std::string_view(escaped, sizeof(escaped)));
+                break;
+            }
+        }
+
+        start = i + 1;
+    }
+
+    emit(text.substr(start));
+}
+
+} // namespace
+
+TextWriter::TextWriter(std::ostream& output, Format format, size_t buffer_size) :
+        stream_{&output},
+        format_{format} {
+
+    if (buffer_size < MIN_BUFFER_SIZE) {
+        throw std::invalid_argument("Invalid buffer size");
+    }
+
+    buffer_.resize(buffer_size);
+}
+
+TextWriter::TextWriter(int descriptor, Format format, size_t buffer_size) :
+        descriptor_{descriptor},
+        format_{format} {
+
+    if (descriptor < 0) {
+        throw std::invalid_argument("Invalid file descriptor");
+    }
+
+    if (buffer_size < MIN_BUFFER_SIZE) {
+        throw std::invalid_argument("Invalid buffer size");
+    }
+
+    buffer_.resize(buffer_size);
+}
+
+TextWriter::~TextWriter() {
+    try {
+        flush();
+    } catch (...) {
+        // Errors are reported only by explicit flushes
+    }
+}
+
+void TextWriter::set_delimiter(char delimiter) {
+    if (delimiter == '"' || delimiter == '\n' || delimiter == '\r') {
+        throw std::invalid_argument("Invalid CSV delimiter");
+    }
+
+    delimiter_ = delimiter;
+}
+
+void TextWriter::set_header(bool enabled) noexcept {
+    header_ = enabled;
+}
+
+size_t TextWriter::write(ResultSet& result) {
+    auto metadata = result.metadata();
+    size_t columns = metadata->column_count();
+    std::vector<std::string> keys;
+
+    if (format_ == Format::CSV) {
+        if (header_ && !header_written_) {
+            write_header(*metadata);
+        }
+
+        header_written_ = true;
+    } else {
+        // The keys are escaped once, instead of once per row
+        keys.resize(columns);
+
+        for (size_t i = 0; i < columns; i++) {
+            keys[i] = i == 0 ? "{\"" : ",\"";
+            escape_json(metadata->column(static_cast<column_t>(i)).name,
+                    [&](std::string_view piece) { keys[i].append(piece); });
+            keys[i].append("\":");
+        }
+    }
+
+    size_t rows = 0;
+
+    do {
+        if (format_ == Format::CSV) {
+            write_csv_row(result, columns);
+        } else {
+            write_json_row(result, keys);
+        }
+
+        rows++;
+    } while (result.next());
+
+    return rows;
+}
+
+size_t TextWriter::write(Statement& statement) {
+    Cursor cursor = statement.query();
+    size_t rows = 0;
+
+    try {
+        if (cursor) {
+            rows = write(*cursor);
+        } else if (format_ == Format::CSV) {
+            // The metadata gives the header, as there's no row
+            if (header_ && !header_written_) {
+                write_header(*statement.metadata());
+            }
+
+            header_written_ = true;
+        }
+    } catch (...) {
+        statement.reset();
+        throw;
+    }
+
+    statement.reset();
+
+    return rows;
+}
+
+void TextWriter::flush() {
+    size_t used = used_;
+    used_ = 0;
+
+    output(buffer_.data(), used);
+
+    if (stream_ != nullptr) {
+        stream_->flush();
+    }
+}
+
+void TextWriter::write_header(const ResultSetMetadata& metadata) {
+    for (size_t i = 0; i < metadata.column_count(); i++) {
+        if (i > 0) {
+            append(delimiter_);
+        }
+
+        write_csv_text(metadata.column(static_cast<column_t>(i)).name);
+    }
+
+    append('\n');
+}
+
+void TextWriter::write_csv_row(const ResultSet& result, size_t columns) {
+    for (size_t i = 0; i < columns; i++) {
+        auto column = static_cast<column_t>(i);
+
+        if (i > 0) {
+            append(delimiter_);
+        }
+
+        switch (result.data_type(column)) {
+            case ResultSet::DataType::INTEGER:
+                write_number(result.int64(column));
+                break;
+            case ResultSet::DataType::FLOAT:
+                write_number(result.dbl(column));
+                break;
+            case ResultSet::DataType::TEXT:
+                write_csv_text(result.text_view(column));
+                break;
+            case ResultSet::DataType::BLOB:
+                write_hex(result.blob_view(column));
+                break;
+            case ResultSet::DataType::NULL_VALUE:
+                break;
+        }
+    }
+
+    append('\n');
+}
+
+void TextWriter::write_json_row(const ResultSet& result, const std::vector<std::string>& keys) {
+    if (keys.empty()) {
+        append('{');
+    }
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto column = static_cast<column_t>(i);
+        append(keys[i]);
+
+        switch (result.data_type(column)) {
+            case ResultSet::DataType::INTEGER:
+                write_number(result.int64(column));
+                break;
+            case ResultSet::DataType::FLOAT: {
+                double value = result.dbl(column);
+
+                if (std::isfinite(value)) {
+                    write_number(value);
+                } else {
+                    append("null");
+                }
+                break;
+            }
+            case ResultSet::DataType::TEXT:
+                write_json_text(result.text_view(column));
+                break;
+            case ResultSet::DataType::BLOB:
+                append('"');
+                write_hex(result.blob_view(column));
+                append('"');
+                break;
+            case ResultSet::DataType::NULL_VALUE:
+                append("null");
+                break;
+        }
+    }
+
+    append("}\n");
+}
+
+void TextWriter::write_csv_text(std::string_view text) {
+    size_t special = find(text, 0, CsvSpecial{delimiter_});
+
+    if (special == text.size()) {
+        append(text);
+        return;
+    }
+
+    append('"');
+    size_t start = 0;
+
+    // Quotes are doubled, all other characters are kept
+    for (size_t i = find(text, special, CsvQuote()); i < text.size();
+            i = find(text, start, CsvQuote())) {
+
+        append(text.substr(start, i + 1 - start));
+        append('"');
+        start = i + 1;
+    }
+
+    append(text.substr(start));
+    append('"');
+}
+
+void TextWriter::write_json_text(std::string_view text) {
+    append('"');
+    escape_json(text, [this](std::string_view piece) { append(piece); });
+    append('"');
+}
+
+void TextWriter::write_hex(BlobView blob) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    size_t chunk = buffer_.size() / 2;
+
+    for (size_t offset = 0; offset < blob.size(); offset += chunk) {
+        size_t size = std::min(chunk, blob.size() - offset);
+        char* out = reserve(size * 2);
+
+        for (size_t i = 0; i < size; i++) {
+            auto byte = static_cast<uint8_t>(blob[offset + i]);
+            out[i * 2] = HEX[byte >> 4U];
+            out[i * 2 + 1] = HEX[byte & 0xFU];
+        }
+
+        used_ += size * 2;
+    }
+}
+
+template<typename T>
+void TextWriter::write_number(T value) {
+    char* out = reserve(MIN_BUFFER_SIZE);
+    auto result = std::to_chars(out, out + MIN_BUFFER_SIZE, value);
+
+    used_ += static_cast<size_t>(result.ptr - out);
+}
+
+void TextWriter::append(std::string_view text) {
+    // Large texts are written directly, without copying them to the buffer
+    if (text.size() > buffer_.size()) {
+        flush();
+        output(text.data(), text.size());
+        return;
+    }
+
+    std::memcpy(reserve(text.size()), text.data(), text.size());
+    used_ += text.size();
+}
+
+void TextWriter::append(char c) {
+    *reserve(1) = c;
+    used_++;
+}
+
+char* TextWriter::reserve(size_t size) {
+    if (buffer_.size() - used_ < size) {
+        flush();
+    }
+
+    return buffer_.data() + used_;
+}
+
+void TextWriter::output(const char* data, size_t size) {
+    if (stream_ != nullptr) {
+        stream_->write(data, static_cast<std::streamsize>(size));
+
+        if (!*stream_) {
+            throw std::logic_error("Failed to write text output");
+        }
+
+        return;
+    }
+
+    while (size > 0) {
+        ssize_t written = ::write(descriptor_, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::logic_error("Failed to write text output");
+        }
+
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace cppdbc
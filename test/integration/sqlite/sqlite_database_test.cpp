@@ -20,13 +20,148 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory_resource>
 #include <gtest/gtest.h>
 #include <memory>
+#include <numeric>
+#include <sstream>
+#include <thread>
 
+#include "cppdbc/arrow_writer.hpp"
+#include "cppdbc/prefetching_resultset.hpp"
+#include "cppdbc/sqlite/sqlite_connection_pool.hpp"
 #include "cppdbc/sqlite/sqlite_database.hpp"
+#include "cppdbc/text_writer.hpp"
+#include "cppdbc/sqlite/sqlite_typed_statement.hpp"
+
+struct User {
+    int64_t id;
+    std::string name;
+    double score;
+};
+
+CPPDBC_MAPPING(User, &User::id, &User::name, &User::score);
+
+struct Profile {
+    int64_t id;
+    std::optional<std::string> nickname;
+    std::optional<double> rating;
+};
+
+CPPDBC_MAPPING(Profile, &Profile::id, &Profile::nickname, &Profile::rating);
 
 namespace cppdbc {
 
+namespace {
+
+// Minimal reader of the Arrow IPC messages written by the Arrow writer
+struct ArrowMessage {
+    std::string metadata;
+    std::string body;
+};
+
+struct ArrowRecordBatch {
+    int64_t length;
+    std::vector<std::pair<int64_t, int64_t>> nodes;
+    std::vector<std::pair<int64_t, int64_t>> buffers;
+};
+
+template<typename T>
+T read_flatbuffer(const std::string& buffer, size_t position) {
+    T value{};
+    std::memcpy(&value, buffer.data() + position, sizeof(T));
+    return value;
+}
+
+// Position of a field of a flatbuffer table, or zero when it's absent
+size_t flatbuffer_field(const std::string& buffer, size_t table, uint16_t field) {
+    size_t vtable = table - static_cast<size_t>(read_flatbuffer<int32_t>(buffer, table));
+    auto size = read_flatbuffer<uint16_t>(buffer, vtable);
+
+    if (4u + field * 2u >= size) {
+        return 0;
+    }
+
+    auto offset = read_flatbuffer<uint16_t>(buffer, vtable + 4 + field * 2u);
+    return offset == 0 ? 0 : table + offset;
+}
+
+size_t flatbuffer_offset(const std::string& buffer, size_t position) {
+    return position + read_flatbuffer<uint32_t>(buffer, position);
+}
+
+// Header of a message, which is the table at its field 2
+size_t arrow_header(const ArrowMessage& message) {
+    size_t root = flatbuffer_offset(message.metadata, 0);
+    return flatbuffer_offset(message.metadata, flatbuffer_field(message.metadata, root, 2));
+}
+
+std::vector<ArrowMessage> read_arrow_messages(const std::string& stream) {
+    std::vector<ArrowMessage> messages;
+    size_t position = 0;
+
+    while (position + 8 <= stream.size()) {
+        auto size = static_cast<size_t>(read_flatbuffer<int32_t>(stream, position + 4));
+        if (size == 0) {
+            break;
+        }
+
+        ArrowMessage message;
+        message.metadata = stream.substr(position + 8, size);
+
+        size_t root = flatbuffer_offset(message.metadata, 0);
+        size_t body_length = flatbuffer_field(message.metadata, root, 3);
+        auto body_size = body_length == 0 ? 0 :
+                static_cast<size_t>(read_flatbuffer<int64_t>(message.metadata, body_length));
+
+        message.body = stream.substr(position + 8 + size, body_size);
+        position += 8 + size + body_size;
+        messages.push_back(std::move(message));
+    }
+
+    return messages;
+}
+
+// Type of each field of a schema message (Arrow Type union)
+std::vector<uint8_t> read_arrow_field_types(const ArrowMessage& message) {
+    const std::string& buffer = message.metadata;
+    size_t fields = flatbuffer_offset(buffer, flatbuffer_field(buffer, arrow_header(message), 1));
+    std::vector<uint8_t> types;
+
+    for (uint32_t i = 0; i < read_flatbuffer<uint32_t>(buffer, fields); i++) {
+        size_t field = flatbuffer_offset(buffer, fields + 4 + i * 4);
+        size_t type = flatbuffer_field(buffer, field, 2);
+        types.push_back(type == 0 ? 0 : read_flatbuffer<uint8_t>(buffer, type));
+    }
+
+    return types;
+}
+
+ArrowRecordBatch read_arrow_record_batch(const ArrowMessage& message) {
+    const std::string& buffer = message.metadata;
+    size_t header = arrow_header(message);
+    ArrowRecordBatch batch{read_flatbuffer<int64_t>(buffer, flatbuffer_field(buffer, header, 0)), {}, {}};
+
+    auto read_structs = [&](uint16_t field, auto& structs) {
+        size_t vector = flatbuffer_offset(buffer, flatbuffer_field(buffer, header, field));
+
+        for (uint32_t i = 0; i < read_flatbuffer<uint32_t>(buffer, vector); i++) {
+            structs.emplace_back(read_flatbuffer<int64_t>(buffer, vector + 4 + i * 16),
+                    read_flatbuffer<int64_t>(buffer, vector + 12 + i * 16));
+        }
+    };
+
+    read_structs(1, batch.nodes);
+    read_structs(2, batch.buffers);
+
+    return batch;
+}
+
+} // namespace
+
 class SQLiteDatabaseTest : public ::testing::Test {
 protected:
     const char* SQL_GET_VERSION = "SELECT SQLITE_VERSION();";
@@ -138,6 +273,1469 @@ TEST_F(SQLiteDatabaseTest, GetResultSet) {
     EXPECT_FALSE(result->next());
 }
 
+TEST_F(SQLiteDatabaseTest, ExecuteStatementAgainAfterReset) {
+    auto statement = database_->create_statement(SQL_CREATE_TABLE_INT);
+    statement->execute();
+
+    statement = database_->create_statement(SQL_INSERT_VALUE);
+
+    for (int32_t i = 1; i <= 3; i++) {
+        statement->reset();
+        statement->bind(i, 0);
+        EXPECT_EQ(statement->execute(), nullptr);
+    }
+
+    statement = database_->create_statement(SQL_SELECT_VALUE);
+    auto result = statement->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1);
+
+    statement->reset();
+    EXPECT_FALSE(result->next());
+
+    result = statement->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1);
+    ASSERT_TRUE(result->next());
+    EXPECT_EQ(result->int32(0), 2);
+}
+
+TEST_F(SQLiteDatabaseTest, ClearBindingsSetsParametersToNull) {
+    auto statement = database_->create_statement(SQL_CREATE_TABLE_TEXT);
+    statement->execute();
+
+    statement = database_->create_statement(SQL_INSERT_VALUE);
+    statement->bind(std::string("value"), 0);
+    statement->execute();
+
+    statement->reset();
+    statement->clear_bindings();
+    statement->execute();
+
+    statement = database_->create_statement("SELECT count(*) FROM test WHERE id IS NULL;");
+    auto result = statement->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateStatementReusesCachedStatement) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE);
+
+    database->create_statement(SQL_CREATE_TABLE_INT)->execute();
+
+    for (int32_t i = 1; i <= 3; i++) {
+        auto statement = database->create_statement(SQL_INSERT_VALUE);
+        ASSERT_TRUE(statement->pending());
+
+        statement->bind(i, 0);
+        statement->execute();
+    }
+
+    auto stats = database->statement_cache_stats();
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.hits, 2);
+
+    auto result = database->create_statement("SELECT count(*) FROM test;")->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 3);
+}
+
+TEST_F(SQLiteDatabaseTest, MovingDatabaseInvalidatesStatements) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE);
+
+    database->execute_script("CREATE TABLE test (id INTEGER); INSERT INTO test VALUES (1), (2);");
+
+    auto statement = database->create_statement(SQL_SELECT_VALUE);
+    auto cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    auto moved = std::make_shared<SQLiteDatabase>(std::move(*database));
+    EXPECT_FALSE(cursor->next());
+    EXPECT_THROW(statement->execute(), std::logic_error);
+
+    auto other = moved->create_statement(SQL_SELECT_VALUE);
+    auto target = std::make_shared<SQLiteDatabase>("test.db", SQLiteDatabase::SQLiteMode::CREATE);
+    *target = std::move(*moved);
+    EXPECT_THROW(other->execute(), std::logic_error);
+
+    statement.reset();
+    other.reset();
+    EXPECT_EQ(target->create_statement("SELECT count(*) FROM test;")->query_scalar<int64_t>(), 2);
+}
+
+TEST_F(SQLiteDatabaseTest, QueryScalarOfInvalidStatementKeepsFailure) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE);
+
+    auto statement = database->create_statement(SQL_GET_VERSION);
+    auto moved = std::make_shared<SQLiteDatabase>(std::move(*database));
+
+    // The failure to query isn't replaced by the failure to reset
+    try {
+        statement->query_scalar<std::string>();
+        FAIL() << "Query of invalid statement didn't throw";
+    } catch (const std::logic_error& e) {
+        EXPECT_STREQ(e.what(), "Cannot execute invalid statement");
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteBatch) {
+    database_->create_statement(SQL_CREATE_TABLE_INT)->execute();
+
+    std::vector<int32_t> rows(1000);
+    std::iota(rows.begin(), rows.end(), 1);
+
+    auto batch = database_->create_statement(SQL_INSERT_VALUE)->execute_batch(rows);
+    ASSERT_TRUE(batch.succeeded());
+    EXPECT_EQ(batch.changes.size(), rows.size());
+    EXPECT_EQ(batch.changes.front(), 1);
+
+    auto result = database_->create_statement("SELECT count(*) FROM test;")->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1000);
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteBatchRollsBackOnFailure) {
+    database_->create_statement(SQL_CREATE_TABLE_INT)->execute();
+
+    std::vector<std::tuple<int32_t>> rows{{1}, {2}, {2}, {3}};
+
+    auto batch = database_->create_statement(SQL_INSERT_VALUE)->execute_batch(rows);
+    ASSERT_FALSE(batch.succeeded());
+    EXPECT_EQ(*batch.failed_row, 2);
+    EXPECT_THROW(std::rethrow_exception(batch.error), constraint_violation);
+
+    auto result = database_->create_statement("SELECT count(*) FROM test;")->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 0);
+}
+
+TEST_F(SQLiteDatabaseTest, BindAllValues) {
+    const std::string text = "text";
+
+    auto statement = database_->create_statement("SELECT ?, ?, ?;");
+    statement->bind_all(int64_t(1) << 40, 2.5, text);
+
+    auto result = statement->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int64(0), int64_t(1) << 40);
+    EXPECT_DOUBLE_EQ(result->dbl(1), 2.5);
+    EXPECT_EQ(result->str(2), "text");
+}
+
+TEST_F(SQLiteDatabaseTest, BindNamedParameters) {
+    auto statement = database_->create_statement("SELECT :first, @second, $third, :first;");
+
+    uint16_t third = statement->parameter_index("$third");
+    EXPECT_EQ(third, 2);
+
+    statement->bind(1, ":first");
+    statement->bind(std::string("two"), "@second");
+    statement->bind(3.5, third);
+
+    auto result = statement->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1);
+    EXPECT_EQ(result->str(1), "two");
+    EXPECT_DOUBLE_EQ(result->dbl(2), 3.5);
+    EXPECT_EQ(result->int32(3), 1);
+}
+
+TEST_F(SQLiteDatabaseTest, BindTextWithoutCopy) {
+    database_->create_statement(SQL_CREATE_TABLE_TEXT)->execute();
+
+    std::string large(1 << 20, 'a');
+    auto shared = std::make_shared<const std::string>(1 << 20, 'b');
+    std::string_view view = "static";
+
+    auto statement = database_->create_statement(SQL_INSERT_VALUE);
+    std::vector<std::function<void()>> binds{
+            [&]() { statement->bind(std::move(large), 0); },
+            [&]() { statement->bind(shared, 0); },
+            [&]() { statement->bind(view, 0, Statement::Lifetime::STATIC); }};
+
+    for (const auto& bind : binds) {
+        statement->reset();
+        bind();
+        statement->execute();
+    }
+
+    auto result = database_->create_statement(
+            "SELECT length(id), substr(id, 1, 1) FROM test;")->execute();
+
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1 << 20);
+    EXPECT_EQ(result->str(1), "a");
+
+    ASSERT_TRUE(result->next());
+    EXPECT_EQ(result->int32(0), 1 << 20);
+    EXPECT_EQ(result->str(1), "b");
+
+    ASSERT_TRUE(result->next());
+    EXPECT_EQ(result->int32(0), 6);
+}
+
+TEST_F(SQLiteDatabaseTest, FailedBindOfMovedTextKeepsPreviousValue) {
+    auto statement = database_->create_statement("SELECT ?;");
+    statement->bind(std::string(100, 'a'), 0);
+    statement->query();
+
+    // SQLite refuses to bind while the statement is running
+    EXPECT_THROW(statement->bind(std::string(100, 'b'), 0), std::invalid_argument);
+
+    statement->reset();
+    EXPECT_EQ(statement->query_scalar<std::string>(), std::string(100, 'a'));
+}
+
+TEST_F(SQLiteDatabaseTest, BindBlobWithoutCopy) {
+    database_->create_statement("CREATE TABLE test(id BLOB);")->execute();
+
+    std::vector<std::byte> moved(1 << 20, std::byte{'a'});
+    auto owned = std::make_unique<std::byte[]>(1 << 10);
+    auto shared = std::make_shared<const std::vector<std::byte>>(1 << 15, std::byte{'c'});
+    owned[0] = std::byte{'b'};
+
+    auto statement = database_->create_statement(SQL_INSERT_VALUE);
+    std::vector<std::function<void()>> binds{
+            [&]() { statement->bind(std::move(moved), 0); },
+            [&]() { statement->bind(std::move(owned), 1 << 10, 0); },
+            [&]() { statement->bind(shared, 0); }};
+
+    for (const auto& bind : binds) {
+        statement->reset();
+        bind();
+        statement->execute();
+    }
+
+    statement.reset();
+    EXPECT_EQ(shared.use_count(), 1);
+
+    auto result = database_->create_statement(
+            "SELECT length(id), hex(substr(id, 1, 1)) FROM test;")->execute();
+
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1 << 20);
+    EXPECT_EQ(result->str(1), "61");
+
+    ASSERT_TRUE(result->next());
+    EXPECT_EQ(result->int32(0), 1 << 10);
+    EXPECT_EQ(result->str(1), "62");
+
+    ASSERT_TRUE(result->next());
+    EXPECT_EQ(result->int32(0), 1 << 15);
+    EXPECT_EQ(result->str(1), "63");
+}
+
+TEST_F(SQLiteDatabaseTest, StreamBlobInChunks) {
+    constexpr size_t size = 1 << 20;
+    constexpr size_t chunk_size = 1 << 12;
+
+    database_->create_statement("CREATE TABLE test(data BLOB);")->execute();
+
+    auto statement = database_->create_statement("INSERT INTO test VALUES(?);");
+    statement->bind_zeroblob(size, 0);
+    statement->execute();
+
+    statement->reset();
+    statement->bind_zeroblob(chunk_size, 0);
+    statement->execute();
+
+    auto sqlite = std::dynamic_pointer_cast<SQLiteDatabase>(database_);
+    auto stream = sqlite->open_blob("test", "data", 1, true);
+    ASSERT_EQ(stream->size(), size);
+
+    std::vector<uint8_t> chunk(chunk_size);
+    for (size_t offset = 0; offset < size; offset += chunk_size) {
+        std::fill(chunk.begin(), chunk.end(), static_cast<uint8_t>(offset / chunk_size));
+        stream->write(offset, chunk.data(), chunk.size());
+    }
+
+    stream->read(size - chunk_size, chunk.data(), chunk.size());
+    EXPECT_EQ(chunk.front(), static_cast<uint8_t>(size / chunk_size - 1));
+
+    stream->reopen(2);
+    ASSERT_EQ(stream->size(), chunk_size);
+
+    stream->read(0, chunk.data(), chunk.size());
+    EXPECT_EQ(std::count(chunk.begin(), chunk.end(), 0), chunk_size);
+
+    stream.reset();
+
+    auto result = database_->create_statement(
+            "SELECT hex(substr(data, 4097, 1)) FROM test WHERE rowid = 1;")->execute();
+
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->str(0), "01");
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteTypedStatement) {
+    struct Record {
+        int64_t id;
+        std::string name;
+        std::optional<double> value;
+    };
+
+    auto sqlite = std::dynamic_pointer_cast<SQLiteDatabase>(database_);
+    database_->create_statement(
+            "CREATE TABLE test(id INTEGER, name TEXT, value REAL);")->execute();
+
+    SQLiteTypedStatement<std::tuple<int64_t, std::string, std::optional<double>>, std::tuple<>>
+            insert(sqlite, "INSERT INTO test VALUES(?, ?, ?);");
+
+    EXPECT_EQ(insert.execute(1, "one", 1.5), 1);
+    EXPECT_EQ(insert.execute(2, "two", std::nullopt), 1);
+
+    SQLiteTypedStatement<std::tuple<int64_t>, std::tuple<int64_t, std::string,
+            std::optional<double>>> select(sqlite, "SELECT * FROM test WHERE id >= ?;");
+
+    select.bind(1);
+    ASSERT_TRUE(select.next());
+    EXPECT_EQ(select.row(), std::make_tuple(1, std::string("one"), std::optional<double>(1.5)));
+
+    ASSERT_TRUE(select.next());
+    auto record = select.row_as<Record>();
+    EXPECT_EQ(record.id, 2);
+    EXPECT_EQ(record.name, "two");
+    EXPECT_FALSE(record.value.has_value());
+
+    EXPECT_FALSE(select.next());
+
+    std::vector<int64_t> ids;
+    select.for_each([&](int64_t id, const std::string&, std::optional<double>) {
+        ids.push_back(id);
+    }, 2);
+
+    EXPECT_EQ(ids, std::vector<int64_t>{2});
+    EXPECT_THROW((SQLiteTypedStatement<std::tuple<>, std::tuple<int64_t>>(sqlite,
+            "SELECT id, name FROM test;")), std::invalid_argument);
+}
+
+TEST_F(SQLiteDatabaseTest, ReadTypedStatementColumnOfOtherTypeThrowsException) {
+    auto sqlite = std::dynamic_pointer_cast<SQLiteDatabase>(database_);
+    database_->execute_script("CREATE TABLE test(id); INSERT INTO test VALUES(1), ('two');");
+
+    SQLiteTypedStatement<std::tuple<>, std::tuple<int64_t>> select(sqlite,
+            "SELECT id FROM test;");
+
+    ASSERT_TRUE(select.next());
+    EXPECT_EQ(std::get<0>(select.row()), 1);
+
+    // The type is checked on every row, as SQLite columns can mix types
+    ASSERT_TRUE(select.next());
+    EXPECT_THROW(select.row(), std::invalid_argument);
+
+    SQLiteTypedStatement<std::tuple<>, std::tuple<double>> real(sqlite,
+            "SELECT id FROM test WHERE id = 1;");
+
+    ASSERT_TRUE(real.next());
+    EXPECT_DOUBLE_EQ(std::get<0>(real.row()), 1.0);
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteTypedStatementDoesNotKeepParameters) {
+    auto sqlite = std::dynamic_pointer_cast<SQLiteDatabase>(database_);
+
+    SQLiteTypedStatement<std::tuple<std::string>, std::tuple<std::optional<std::string>>>
+            select(sqlite, "SELECT ?;");
+
+    select.execute(std::string(100, 'a'));
+
+    // The parameter was destroyed, so it's no longer bound
+    select.reset();
+    ASSERT_TRUE(select.next());
+    EXPECT_EQ(std::get<0>(select.row()), std::nullopt);
+}
+
+TEST_F(SQLiteDatabaseTest, ForEachResetsTypedStatementWhenFunctionThrows) {
+    auto sqlite = std::dynamic_pointer_cast<SQLiteDatabase>(database_);
+    database_->execute_script("CREATE TABLE test(id INTEGER); INSERT INTO test VALUES(1), (2);");
+
+    SQLiteTypedStatement<std::tuple<int64_t>, std::tuple<int64_t>> select(sqlite,
+            "SELECT id FROM test WHERE id >= ?;");
+
+    EXPECT_THROW(select.for_each([](int64_t) { throw std::runtime_error("Failure"); }, 1),
+            std::runtime_error);
+
+    // The statement isn't left running, so the table can be dropped
+    EXPECT_NO_THROW(database_->execute_script("DROP TABLE test;"));
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteScript) {
+    database_->execute_script(R"(
+            -- Schema
+            CREATE TABLE test(id INTEGER NOT NULL, PRIMARY KEY(id));
+            CREATE INDEX test_id ON test(id);
+
+            INSERT INTO test VALUES(1);
+            INSERT INTO test VALUES(2);
+            SELECT * FROM test;
+            )");
+
+    EXPECT_TRUE(database_->has_table("test"));
+
+    auto result = database_->create_statement("SELECT count(*) FROM test;")->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 2);
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteScriptStopsAtFailingStatement) {
+    const std::string script = "CREATE TABLE test(id INTEGER NOT NULL, PRIMARY KEY(id));"
+                               "INSERT INTO test VALUES(1);"
+                               "INSERT INTO test VALUES(1);"
+                               "INSERT INTO test VALUES(2);";
+    try {
+        database_->execute_script(script);
+        FAIL() << "Expected script_error";
+    } catch (const script_error& e) {
+        EXPECT_EQ(e.statement(), 2);
+        EXPECT_EQ(e.offset(), script.find("INSERT INTO test VALUES(1);", 60));
+    }
+
+    auto result = database_->create_statement("SELECT count(*) FROM test;")->execute();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->int32(0), 1);
+}
+
+TEST_F(SQLiteDatabaseTest, QueryStatementWithCursor) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, name TEXT);"
+                              "INSERT INTO test VALUES(1, 'one');"
+                              "INSERT INTO test VALUES(2, 'two');");
+
+    auto statement = database_->create_statement("SELECT id, name FROM test ORDER BY id;");
+    std::vector<int32_t> ids;
+
+    for (Cursor cursor = statement->query(); cursor; cursor.next()) {
+        ids.push_back(cursor->int32(0));
+    }
+
+    EXPECT_EQ(ids, (std::vector<int32_t>{1, 2}));
+
+    statement->reset();
+    auto row = statement->query_one<std::tuple<int64_t, std::string>>();
+    EXPECT_EQ(row, std::make_tuple(int64_t{1}, std::string("one")));
+
+    auto count = database_->create_statement("SELECT count(*) FROM test WHERE id > ?;");
+    for (int64_t id = 0; id < 3; id++) {
+        count->bind(id, 0);
+        EXPECT_EQ(count->query_scalar<int64_t>(), 2 - id);
+    }
+
+    auto missing = database_->create_statement("SELECT id FROM test WHERE id = 3;");
+    EXPECT_EQ(missing->query_scalar<int64_t>(), std::nullopt);
+}
+
+TEST_F(SQLiteDatabaseTest, QueryTemporaryStatementWithCursor) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE);
+
+    database->execute_script("CREATE TABLE test(id INTEGER);"
+                             "INSERT INTO test VALUES(1), (2), (3);");
+
+    for (size_t capacity : {size_t{0}, size_t{16}}) {
+        database->set_statement_cache_capacity(capacity);
+        std::vector<int32_t> ids;
+
+        Cursor cursor = database->create_statement("SELECT id FROM test ORDER BY id;")->query();
+        for (; cursor; cursor.next()) {
+            ids.push_back(cursor->int32(0));
+        }
+
+        EXPECT_EQ(ids, (std::vector<int32_t>{1, 2, 3}));
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, GetTextAndBlobViews) {
+    database_->execute_script("CREATE TABLE test(name TEXT, data BLOB);"
+                              "INSERT INTO test VALUES('one', x'00010203');"
+                              "INSERT INTO test VALUES('', x'');");
+
+    auto statement = database_->create_statement("SELECT name, data FROM test;");
+    Cursor cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    EXPECT_EQ(cursor->text_view(0), "one");
+    BlobView blob = cursor->blob_view(1);
+    ASSERT_EQ(blob.size(), 4);
+    EXPECT_EQ(blob[3], std::byte{3});
+
+    ASSERT_TRUE(cursor.next());
+    EXPECT_EQ(cursor->text_view(0), "");
+    EXPECT_TRUE(cursor->blob_view(1).empty());
+}
+
+TEST_F(SQLiteDatabaseTest, GetValuesWithoutTypeChecking) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, value REAL);"
+                              "INSERT INTO test VALUES(1, 1.5);"
+                              "INSERT INTO test VALUES(2, 2);");
+
+    auto statement = database_->create_statement("SELECT id, value FROM test;");
+    Cursor cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    EXPECT_DOUBLE_EQ(cursor->dbl(1), 1.5);
+    ASSERT_TRUE(cursor.next());
+
+    cursor->set_type_checking(false);
+    EXPECT_EQ(cursor->int32(0), 2);
+    EXPECT_DOUBLE_EQ(cursor->dbl(1), 2.0);
+}
+
+TEST_F(SQLiteDatabaseTest, FetchBatches) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, value REAL, name TEXT, data BLOB);"
+                              "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 "
+                              "FROM seq WHERE n < 1000) INSERT INTO test "
+                              "SELECT n, n / 2.0, 'row' || n, NULL FROM seq;");
+
+    auto statement = database_->create_statement("SELECT * FROM test ORDER BY id;");
+    Cursor cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    ColumnBatch batch;
+    size_t total = 0;
+    int64_t sum = 0;
+
+    while (cursor->fetch_batch(batch, 256) > 0) {
+        ASSERT_EQ(batch.columns.size(), 4);
+        EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+        EXPECT_EQ(batch.columns[1].type, ResultSet::DataType::FLOAT);
+        EXPECT_EQ(batch.columns[2].type, ResultSet::DataType::TEXT);
+        EXPECT_EQ(batch.columns[3].type, ResultSet::DataType::BLOB);
+
+        for (size_t row = 0; row < batch.rows; row++) {
+            int64_t id = batch.columns[0].integers[row];
+            sum += id;
+
+            EXPECT_DOUBLE_EQ(batch.columns[1].reals[row], static_cast<double>(id) / 2);
+            EXPECT_EQ(batch.columns[2].text(row), "row" + std::to_string(id));
+            EXPECT_FALSE(batch.columns[3].valid(row));
+        }
+
+        total += batch.rows;
+    }
+
+    EXPECT_EQ(total, 1000);
+    EXPECT_EQ(sum, 500500);
+}
+
+TEST_F(SQLiteDatabaseTest, FetchBatchesOfMixedDataTypes) {
+    database_->execute_script("CREATE TABLE test(amount NUMERIC, value);"
+                              "INSERT INTO test VALUES(NULL, 1);"
+                              "INSERT INTO test VALUES(3.75, 2.5);"
+                              "INSERT INTO test VALUES(7, 'abc');");
+
+    auto statement = database_->create_statement("SELECT amount, value FROM test LIMIT 2;");
+    Cursor cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    ColumnBatch batch;
+    ASSERT_EQ(cursor->fetch_batch(batch, 10), 2);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::FLOAT);
+    EXPECT_EQ(batch.columns[0].reals, (std::vector<double>{0.0, 3.75}));
+    EXPECT_EQ(batch.columns[1].type, ResultSet::DataType::FLOAT);
+    EXPECT_EQ(batch.columns[1].reals, (std::vector<double>{1.0, 2.5}));
+
+    auto amounts = database_->create_statement("SELECT amount FROM test;");
+    cursor = amounts->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 10), 3);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::FLOAT);
+    EXPECT_EQ(batch.columns[0].reals, (std::vector<double>{0.0, 3.75, 7.0}));
+
+    auto values = database_->create_statement("SELECT value FROM test;");
+    cursor = values->query();
+    ASSERT_TRUE(cursor);
+
+    EXPECT_THROW(cursor->fetch_batch(batch, 10), std::invalid_argument);
+}
+
+TEST_F(SQLiteDatabaseTest, ReuseBatchForResultsOfDifferentDataTypes) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, name TEXT);"
+                              "INSERT INTO test VALUES(1, 'one'), (2, 'two'), (3, 'three');");
+
+    ColumnBatch batch;
+
+    // NULL rows, then INTEGER rows of the same result
+    auto statement = database_->create_statement(
+            "SELECT CASE WHEN id > 1 THEN id END FROM test ORDER BY id;");
+    Cursor cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 1), 1);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::NULL_VALUE);
+    EXPECT_FALSE(batch.columns[0].valid(0));
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 2), 2);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+    EXPECT_EQ(batch.columns[0].integers, (std::vector<int64_t>{2, 3}));
+
+    // INTEGER rows, then TEXT rows of the same result, which can't be stored
+    auto mixed = database_->create_statement(
+            "SELECT CASE WHEN id > 1 THEN name ELSE id END FROM test ORDER BY id;");
+    cursor = mixed->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 1), 1);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+    EXPECT_THROW(cursor->fetch_batch(batch, 1), std::invalid_argument);
+
+    // The data types start over for the result of another statement
+    auto names = database_->create_statement("SELECT name FROM test ORDER BY id;");
+    cursor = names->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 10), 3);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::TEXT);
+    EXPECT_EQ(batch.columns[0].text(2), "three");
+
+    auto nulls = database_->create_statement("SELECT NULL FROM test;");
+    cursor = nulls->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 10), 3);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::NULL_VALUE);
+
+    auto ids = database_->create_statement("SELECT id FROM test ORDER BY id;");
+    cursor = ids->query();
+    ASSERT_TRUE(cursor);
+
+    ASSERT_EQ(cursor->fetch_batch(batch, 10), 3);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+    EXPECT_EQ(batch.columns[0].integers, (std::vector<int64_t>{1, 2, 3}));
+}
+
+TEST_F(SQLiteDatabaseTest, MapRowsToStruct) {
+    database_->create_statement("CREATE TABLE test(id INTEGER, name TEXT, score REAL);")
+            ->execute();
+
+    auto insert = database_->create_statement("INSERT INTO test VALUES(?, ?, ?);");
+    std::vector<User> users{{1, "one", 1.5}, {2, "two", 2.5}, {3, "three", 3.5}};
+
+    for (const auto& user : users) {
+        insert->reset();
+        insert->bind_from(user);
+        insert->execute();
+    }
+
+    auto select = database_->create_statement("SELECT id, name, score FROM test ORDER BY id;");
+    Cursor cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    EXPECT_EQ(cursor->fetch_as<User>().name, "one");
+
+    std::vector<User> fetched;
+    fetched.reserve(users.size());
+
+    EXPECT_EQ(cursor.fetch_all(fetched), users.size());
+    EXPECT_FALSE(cursor);
+
+    ASSERT_EQ(fetched.size(), users.size());
+    for (size_t i = 0; i < users.size(); i++) {
+        EXPECT_EQ(fetched[i].id, users[i].id);
+        EXPECT_EQ(fetched[i].name, users[i].name);
+        EXPECT_DOUBLE_EQ(fetched[i].score, users[i].score);
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, FetchAllRowsWithFailureKeepsReadRows) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, name TEXT, score REAL);"
+                              "INSERT INTO test VALUES(1, 'one', 1.5);"
+                              "INSERT INTO test VALUES(2, NULL, 2.5);");
+
+    auto select = database_->create_statement("SELECT id, name, score FROM test ORDER BY id;");
+    Cursor cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    std::vector<User> users;
+    EXPECT_THROW(cursor.fetch_all(users), std::invalid_argument);
+
+    // The row which failed to be read isn't appended
+    ASSERT_EQ(users.size(), 1);
+    EXPECT_EQ(users[0].name, "one");
+}
+
+TEST_F(SQLiteDatabaseTest, MapNullableColumnsToOptionalMembers) {
+    database_->execute_script("CREATE TABLE test(id INTEGER, nickname TEXT, rating REAL);"
+                              "INSERT INTO test VALUES(1, 'one', NULL);"
+                              "INSERT INTO test VALUES(2, NULL, 2.5);");
+
+    auto select = database_->create_statement("SELECT * FROM test ORDER BY id;");
+    Cursor cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    std::vector<Profile> profiles;
+    EXPECT_EQ(cursor.fetch_all(profiles), 2);
+
+    ASSERT_EQ(profiles.size(), 2);
+    EXPECT_EQ(profiles[0].nickname, "one");
+    EXPECT_EQ(profiles[0].rating, std::nullopt);
+    EXPECT_EQ(profiles[1].nickname, std::nullopt);
+    EXPECT_EQ(profiles[1].rating, 2.5);
+
+    select->reset();
+    cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    PrefetchingResultSet rows(*cursor, 1, 2);
+    auto profile = rows.fetch_as<Profile>();
+    EXPECT_EQ(profile.rating, std::nullopt);
+    ASSERT_TRUE(rows.next());
+
+    rows.fetch_as(profile);
+    EXPECT_EQ(profile.id, 2);
+    EXPECT_EQ(profile.nickname, std::nullopt);
+    EXPECT_EQ(profile.rating, 2.5);
+}
+
+TEST_F(SQLiteDatabaseTest, IterateRowsWithAlgorithms) {
+    database_->execute_script("CREATE TABLE test(id INTEGER);"
+                              "INSERT INTO test VALUES(1), (2), (3), (4);");
+
+    auto statement = database_->create_statement("SELECT id FROM test ORDER BY id;");
+    std::vector<int64_t> ids;
+
+    for (auto& row : statement->rows()) {
+        ids.push_back(row.int64(0));
+    }
+
+    EXPECT_EQ(ids, (std::vector<int64_t>{1, 2, 3, 4}));
+
+    statement->reset();
+    auto rows = statement->rows();
+    auto sum = std::accumulate(rows.begin(), rows.end(), int64_t{0},
+            [](int64_t total, ResultSet& row) { return total + row.int64(0); });
+
+    EXPECT_EQ(sum, 10);
+
+    statement->reset();
+    auto even = statement->rows();
+    EXPECT_EQ(std::count_if(even.begin(), even.end(),
+            [](ResultSet& row) { return row.int64(0) % 2 == 0; }), 2);
+}
+
+TEST_F(SQLiteDatabaseTest, IterateRowsOfTemporaryStatement) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE);
+
+    database->execute_script("CREATE TABLE test(id INTEGER);"
+                             "INSERT INTO test VALUES(1), (2), (3), (4);");
+
+    for (size_t capacity : {size_t{0}, size_t{16}}) {
+        database->set_statement_cache_capacity(capacity);
+        std::vector<int64_t> ids;
+
+        for (auto& row : database->create_statement("SELECT id FROM test ORDER BY id;")->rows()) {
+            ids.push_back(row.int64(0));
+        }
+
+        EXPECT_EQ(ids, (std::vector<int64_t>{1, 2, 3, 4}));
+
+        auto rows = database->create_statement("SELECT id FROM test;")->rows();
+        auto sum = std::accumulate(rows.begin(), rows.end(), int64_t{0},
+                [](int64_t total, ResultSet& row) { return total + row.int64(0); });
+
+        EXPECT_EQ(sum, 10);
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, IteratePrefetchedRows) {
+    database_->execute_script(
+            "CREATE TABLE test(id INTEGER);"
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 100)"
+            "INSERT INTO test SELECT n FROM seq;");
+
+    auto statement = database_->create_statement("SELECT id FROM test ORDER BY id;");
+    int64_t count = 0;
+
+    for (auto& row : statement->rows(8)) {
+        count++;
+        ASSERT_EQ(row.int64(0), count);
+    }
+
+    EXPECT_EQ(count, 100);
+
+    auto rows = database_->create_statement("SELECT id FROM test;")->rows(16);
+    auto sum = std::accumulate(rows.begin(), rows.end(), int64_t{0},
+            [](int64_t total, ResultSet& row) { return total + row.int64(0); });
+
+    EXPECT_EQ(sum, 5050);
+
+    auto empty = database_->create_statement("SELECT id FROM test WHERE id > 100;")->rows(4);
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    EXPECT_THROW(database_->create_statement("SELECT id FROM test;")->rows(0),
+            std::invalid_argument);
+}
+
+TEST_F(SQLiteDatabaseTest, GetResultSetMetadata) {
+    database_->execute_script(
+            "CREATE TABLE metadata (id INTEGER PRIMARY KEY, name TEXT);"
+            "INSERT INTO metadata (name) VALUES ('a'), ('b');");
+
+    auto statement = database_->create_statement(
+            "SELECT name, id AS key, count(*) AS total FROM metadata GROUP BY id");
+    auto cursor = statement->query();
+    auto metadata = cursor->metadata();
+
+    ASSERT_EQ(metadata->column_count(), 3);
+    EXPECT_EQ(metadata->column(0).name, "name");
+    EXPECT_EQ(metadata->column(0).declared_type, "TEXT");
+    EXPECT_EQ(metadata->column(1).name, "key");
+    EXPECT_EQ(metadata->column(2).name, "total");
+    EXPECT_TRUE(metadata->column(2).table.empty());
+
+#ifdef SQLITE_ENABLE_COLUMN_METADATA
+    EXPECT_EQ(metadata->column(0).table, "metadata");
+    EXPECT_EQ(metadata->column(1).origin, "id");
+#else
+    EXPECT_TRUE(metadata->column(0).table.empty());
+    EXPECT_TRUE(metadata->column(1).origin.empty());
+#endif
+
+    auto name = cursor->column_index("name");
+    auto key = cursor->column_index("key");
+    std::vector<std::string> names;
+
+    for (; cursor; cursor.next()) {
+        EXPECT_EQ(cursor->int64(key), static_cast<int64_t>(names.size()) + 1);
+        names.push_back(cursor->str(name));
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string>{"a", "b"}));
+
+    statement->reset();
+    EXPECT_EQ(statement->query()->metadata(), metadata);
+
+    statement->reset();
+    database_->execute_script("DROP TABLE metadata");
+}
+
+TEST_F(SQLiteDatabaseTest, BindAndGetNullValues) {
+    database_->execute_script("CREATE TABLE nullable (id INTEGER, name TEXT)");
+
+    auto insert = database_->create_statement("INSERT INTO nullable VALUES (?, ?)");
+    insert->bind_all(1, std::nullopt);
+    insert->execute();
+    insert->reset();
+    insert->bind(std::optional<int64_t>(), 0);
+    insert->bind(std::optional<std::string>("name"), 1);
+    insert->execute();
+
+    auto select = database_->create_statement("SELECT id, name FROM nullable ORDER BY rowid");
+    auto cursor = select->query();
+
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(cursor->data_type(1), ResultSet::DataType::NULL_VALUE);
+    EXPECT_TRUE(cursor->is_null(1));
+    EXPECT_EQ(cursor->get<std::optional<int64_t>>(0), 1);
+    EXPECT_EQ(cursor->get<std::optional<std::string>>(1), std::nullopt);
+
+    ASSERT_TRUE(cursor.next());
+    EXPECT_TRUE(cursor->is_null(0));
+    EXPECT_THROW(cursor->int64(0), std::invalid_argument);
+    EXPECT_EQ(cursor->get<std::optional<std::string>>(1), "name");
+
+    select->reset();
+    database_->execute_script("DROP TABLE nullable");
+}
+
+TEST_F(SQLiteDatabaseTest, FetchAllRowsIntoArena) {
+    database_->execute_script(
+            "CREATE TABLE cache (id INTEGER, name TEXT, score REAL, data BLOB);"
+            "INSERT INTO cache VALUES (1, 'one', 1.5, x'0102'), (2, NULL, 2.5, NULL);");
+
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+            std::pmr::null_memory_resource());
+
+    auto select = database_->create_statement("SELECT * FROM cache ORDER BY id");
+    auto cursor = select->query();
+    ResultTable table = cursor.fetch_all(arena);
+
+    EXPECT_FALSE(cursor);
+    ASSERT_EQ(table.rows(), 2);
+    ASSERT_EQ(table.columns(), 4);
+
+    auto name = std::get<std::string_view>(table.at(0, 1));
+    auto data = std::get<BlobView>(table.at(0, 3));
+
+    EXPECT_EQ(std::get<int64_t>(table.at(0, 0)), 1);
+    EXPECT_EQ(name, "one");
+    EXPECT_DOUBLE_EQ(std::get<double>(table.at(0, 2)), 1.5);
+    ASSERT_EQ(data.size(), 2);
+    EXPECT_EQ(data[1], std::byte(2));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(table.at(1, 1)));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(table.at(1, 3)));
+    EXPECT_THROW((void) table.at(2, 0), std::invalid_argument);
+
+    // The values are copies in the arena
+    select->reset();
+    EXPECT_GE(name.data(), reinterpret_cast<const char*>(buffer.data()));
+    EXPECT_LT(name.data(), reinterpret_cast<const char*>(buffer.data() + buffer.size()));
+
+    database_->execute_script("DROP TABLE cache");
+}
+
+TEST_F(SQLiteDatabaseTest, AppendRowWithFailureKeepsTableRows) {
+    database_->execute_script(
+            "CREATE TABLE cache (id INTEGER, name TEXT);"
+            "INSERT INTO cache VALUES (1, 'one'), (2, printf('%.8192c', 'x')), (3, 'three');");
+
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+            std::pmr::null_memory_resource());
+
+    auto select = database_->create_statement("SELECT * FROM cache ORDER BY id");
+    auto cursor = select->query();
+    ResultTable table(arena, 2);
+
+    table.append(*cursor);
+    ASSERT_TRUE(cursor.next());
+
+    // The text of the second row doesn't fit in the arena
+    EXPECT_THROW(table.append(*cursor), std::bad_alloc);
+    EXPECT_EQ(table.rows(), 1);
+
+    ASSERT_TRUE(cursor.next());
+    table.append(*cursor);
+
+    ASSERT_EQ(table.rows(), 2);
+    EXPECT_EQ(std::get<int64_t>(table.at(1, 0)), 3);
+    EXPECT_EQ(std::get<std::string_view>(table.at(1, 1)), "three");
+
+    select->reset();
+    database_->execute_script("DROP TABLE cache");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteResultSetToArrowStream) {
+    database_->execute_script(
+            "CREATE TABLE export (id INTEGER, score REAL, name TEXT, data BLOB);"
+            "INSERT INTO export VALUES (1, 0.5, 'one', x'01'), (2, 1.5, NULL, x'0203'),"
+            "(3, 2.5, 'three', NULL);");
+
+    auto select = database_->create_statement("SELECT * FROM export");
+    std::ostringstream output;
+    ArrowWriter writer(output);
+
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(writer.write(*cursor, 2), 3);
+    writer.close();
+    EXPECT_THROW(writer.write(*cursor), std::logic_error);
+
+    std::string stream = output.str();
+    const std::string continuation(4, '\xFF');
+    const std::string end = continuation + std::string(4, '\0');
+
+    // Schema and two record batches, followed by the end of stream
+    ASSERT_GT(stream.size(), end.size());
+    EXPECT_EQ(stream.substr(0, 4), continuation);
+    EXPECT_EQ(stream.substr(stream.size() - end.size()), end);
+    EXPECT_NE(stream.find("name"), std::string::npos);
+    EXPECT_NE(stream.find("three"), std::string::npos);
+
+    select->reset();
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteResultSetToArrowFile) {
+    auto select = database_->create_statement("SELECT 1 AS id, 'text' AS name");
+    std::ostringstream output;
+    ArrowWriter writer(output, ArrowWriter::Format::FILE);
+
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(writer.write(*cursor), 1);
+    writer.close();
+
+    std::string file = output.str();
+    const std::string magic("ARROW1\0\0", 8);
+
+    ASSERT_GT(file.size(), magic.size() * 2);
+    EXPECT_EQ(file.substr(0, 8), magic);
+    EXPECT_EQ(file.substr(file.size() - 6), "ARROW1");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteStatementWithoutRowsToArrowStream) {
+    database_->execute_script(
+            "CREATE TABLE export (id INTEGER, score REAL, name TEXT, data BLOB, amount NUMERIC);"
+            "INSERT INTO export VALUES (1, 0.5, 'one', x'01', 2.5);");
+
+    auto select = database_->create_statement("SELECT * FROM export");
+
+    // The schema is the first message, after the continuation and its size
+    auto schema = [](const std::string& stream) {
+        int32_t size = 0;
+        std::memcpy(&size, stream.data() + 4, sizeof(size));
+        return stream.substr(0, 8 + static_cast<size_t>(size));
+    };
+
+    std::ostringstream expected;
+    ArrowWriter writer(expected);
+    EXPECT_EQ(writer.write(*select), 1);
+    writer.close();
+    EXPECT_TRUE(select->pending());
+
+    database_->execute_script("DELETE FROM export;");
+
+    std::ostringstream output;
+    ArrowWriter empty(output);
+    EXPECT_EQ(empty.write(*select), 0);
+    empty.close();
+
+    std::string stream = output.str();
+    const std::string end = std::string(4, '\xFF') + std::string(4, '\0');
+
+    // Schema followed by the end of stream, without record batches
+    ASSERT_GT(stream.size(), 8);
+    EXPECT_EQ(schema(stream), schema(expected.str()));
+    EXPECT_EQ(stream.substr(schema(stream).size()), end);
+    EXPECT_NE(stream.find("amount"), std::string::npos);
+
+    select->reset();
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteArrowSchemaAndRecordBatches) {
+    database_->execute_script(
+            "CREATE TABLE export (id INTEGER, score REAL, name TEXT, data BLOB);"
+            "INSERT INTO export VALUES (1, 0.5, 'one', x'01'), (2, 1.5, NULL, x'0203'),"
+            "(3, 2.5, 'three', NULL);");
+
+    auto select = database_->create_statement("SELECT * FROM export ORDER BY id");
+    std::ostringstream output;
+    ArrowWriter writer(output);
+
+    EXPECT_EQ(writer.write(*select, 2), 3);
+    writer.close();
+
+    auto messages = read_arrow_messages(output.str());
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(read_arrow_field_types(messages[0]), (std::vector<uint8_t>{2, 3, 20, 19}));
+
+    // Validity and values of each column, padded to 8 bytes
+    auto first = read_arrow_record_batch(messages[1]);
+    EXPECT_EQ(first.length, 2);
+    EXPECT_EQ(first.nodes, (std::vector<std::pair<int64_t, int64_t>>{{2, 0}, {2, 0}, {2, 1}, {2, 0}}));
+    EXPECT_EQ(first.buffers, (std::vector<std::pair<int64_t, int64_t>>{
+            {0, 0}, {0, 16},
+            {16, 0}, {16, 16},
+            {32, 1}, {40, 24}, {64, 3},
+            {72, 0}, {72, 24}, {96, 3}}));
+    ASSERT_EQ(messages[1].body.size(), 104);
+    EXPECT_EQ(read_flatbuffer<int64_t>(messages[1].body, 8), 2);
+    EXPECT_DOUBLE_EQ(read_flatbuffer<double>(messages[1].body, 24), 1.5);
+    EXPECT_EQ(messages[1].body.substr(64, 3), "one");
+
+    auto second = read_arrow_record_batch(messages[2]);
+    EXPECT_EQ(second.length, 1);
+    EXPECT_EQ(second.nodes, (std::vector<std::pair<int64_t, int64_t>>{{1, 0}, {1, 0}, {1, 0}, {1, 1}}));
+    EXPECT_EQ(second.buffers, (std::vector<std::pair<int64_t, int64_t>>{
+            {0, 0}, {0, 8},
+            {8, 0}, {8, 8},
+            {16, 0}, {16, 16}, {32, 5},
+            {40, 1}, {48, 16}, {64, 0}}));
+    EXPECT_EQ(read_flatbuffer<int64_t>(messages[2].body, 0), 3);
+    EXPECT_EQ(messages[2].body.substr(32, 5), "three");
+
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteNullColumnsToArrowStream) {
+    database_->execute_script(
+            "CREATE TABLE export (id INTEGER);"
+            "INSERT INTO export VALUES (1), (2), (3), (4);");
+
+    // The first batch has only NULL values of the first column
+    auto select = database_->create_statement(
+            "SELECT CASE WHEN id > 2 THEN id END AS late, NULL AS none FROM export ORDER BY id");
+    std::ostringstream output;
+    ArrowWriter writer(output);
+
+    EXPECT_EQ(writer.write(*select, 2), 4);
+    writer.close();
+
+    auto messages = read_arrow_messages(output.str());
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(read_arrow_field_types(messages[0]), (std::vector<uint8_t>{2, 1}));
+
+    // A Null column has no buffers
+    auto first = read_arrow_record_batch(messages[1]);
+    EXPECT_EQ(first.nodes, (std::vector<std::pair<int64_t, int64_t>>{{2, 2}, {2, 2}}));
+    EXPECT_EQ(first.buffers, (std::vector<std::pair<int64_t, int64_t>>{{0, 1}, {8, 16}}));
+    EXPECT_EQ(messages[1].body[0], '\0');
+
+    auto second = read_arrow_record_batch(messages[2]);
+    EXPECT_EQ(second.nodes, (std::vector<std::pair<int64_t, int64_t>>{{2, 0}, {2, 2}}));
+    EXPECT_EQ(second.buffers, (std::vector<std::pair<int64_t, int64_t>>{{0, 0}, {0, 16}}));
+    EXPECT_EQ(read_flatbuffer<int64_t>(messages[2].body, 0), 3);
+    EXPECT_EQ(read_flatbuffer<int64_t>(messages[2].body, 8), 4);
+
+    // A column with only NULL values has the same type with and without rows
+    for (const char* sql : {"SELECT CASE WHEN id > 4 THEN id END AS late FROM export",
+            "SELECT CASE WHEN id > 4 THEN id END AS late FROM export WHERE id > 4"}) {
+        auto statement = database_->create_statement(sql);
+        std::ostringstream stream;
+        ArrowWriter nulls(stream);
+
+        nulls.write(*statement, 2);
+        nulls.close();
+
+        auto written = read_arrow_messages(stream.str());
+        ASSERT_FALSE(written.empty());
+        EXPECT_EQ(read_arrow_field_types(written[0]), (std::vector<uint8_t>{1}));
+    }
+
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteStatementAsCsv) {
+    database_->execute_script(
+            "CREATE TABLE export (id INTEGER, score REAL, name TEXT, data BLOB);"
+            "INSERT INTO export VALUES (1, 0.5, 'plain text value', x'00ff'),"
+            "(2, NULL, 'a long text with \"quotes\", commas', NULL),"
+            "(3, 2.0, 'line' || char(10) || 'break', x'');");
+
+    auto select = database_->create_statement("SELECT * FROM export ORDER BY id");
+    std::ostringstream output;
+
+    {
+        TextWriter writer(output, TextWriter::Format::CSV, 64);
+        EXPECT_EQ(writer.write(*select), 3);
+    }
+
+    EXPECT_EQ(output.str(),
+            "id,score,name,data\n"
+            "1,0.5,plain text value,00ff\n"
+            "2,,\"a long text with \"\"quotes\"\", commas\",\n"
+            "3,2,\"line\nbreak\",\n");
+
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteStatementWithoutRowsAsCsv) {
+    database_->execute_script("CREATE TABLE export (id INTEGER, name TEXT);");
+
+    auto select = database_->create_statement("SELECT * FROM export ORDER BY id");
+    std::ostringstream output;
+
+    {
+        TextWriter writer(output, TextWriter::Format::CSV);
+        EXPECT_EQ(writer.write(*select), 0);
+        EXPECT_TRUE(select->pending());
+
+        // The header is written only once
+        database_->execute_script("INSERT INTO export VALUES (1, 'one');");
+        EXPECT_EQ(writer.write(*select), 1);
+    }
+
+    EXPECT_EQ(output.str(), "id,name\n1,one\n");
+
+    database_->execute_script("DROP TABLE export");
+}
+
+TEST_F(SQLiteDatabaseTest, WriteStatementAsJson) {
+    auto select = database_->create_statement(
+            "SELECT 1 AS \"i\"\"d\", 'tab\there \"quoted\" back\\slash' AS text, NULL AS none, "
+            "x'0a' AS data, char(1) AS control");
+    std::ostringstream output;
+    TextWriter writer(output, TextWriter::Format::NDJSON);
+
+    EXPECT_EQ(writer.write(*select), 1);
+    writer.flush();
+
+    EXPECT_EQ(output.str(),
+            "{\"i\\\"d\":1,\"text\":\"tab\\there \\\"quoted\\\" back\\\\slash\","
+            "\"none\":null,\"data\":\"0a\",\"control\":\"\\u0001\"}\n");
+}
+
+TEST_F(SQLiteDatabaseTest, PrefetchRowsInBackground) {
+    database_->execute_script(
+            "CREATE TABLE prefetch (id INTEGER, name TEXT, score REAL);"
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 1000)"
+            "INSERT INTO prefetch SELECT n, 'row' || n, CASE WHEN n % 10 THEN n / 4.0 END FROM seq;");
+
+    auto select = database_->create_statement("SELECT * FROM prefetch ORDER BY id");
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    int64_t count = 0;
+
+    {
+        PrefetchingResultSet rows(*cursor, 64, 3);
+
+        for (; rows.pending(); rows.next()) {
+            count++;
+            ASSERT_EQ(rows.int64(0), count);
+            ASSERT_EQ(rows.text_view(1), "row" + std::to_string(count));
+
+            if (count % 10 == 0) {
+                ASSERT_TRUE(rows.is_null(2));
+            } else {
+                ASSERT_DOUBLE_EQ(rows.dbl(2), static_cast<double>(count) / 4.0);
+            }
+        }
+
+        EXPECT_FALSE(rows.next());
+        EXPECT_THROW((void) rows.int64(0), std::logic_error);
+    }
+
+    EXPECT_EQ(count, 1000);
+
+    select->reset();
+    database_->execute_script("DROP TABLE prefetch");
+}
+
+TEST_F(SQLiteDatabaseTest, StopPrefetchingBeforeAllRowsAreConsumed) {
+    auto select = database_->create_statement(
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 100000)"
+            "SELECT n FROM seq");
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    {
+        PrefetchingResultSet rows(*cursor, 16);
+        EXPECT_EQ(rows.get<int64_t>(0), 1);
+        EXPECT_TRUE(rows.next());
+
+        int64_t value = 0;
+        Field field(&value);
+        rows.read(&field, 1);
+        EXPECT_EQ(value, 2);
+    }
+
+    select->reset();
+}
+
+TEST_F(SQLiteDatabaseTest, PrefetchingRethrowsFailureOfSource) {
+    auto select = database_->create_statement(
+            "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 100)"
+            "SELECT CASE WHEN n = 50 THEN abs(-9223372036854775807 - 1) ELSE n END FROM seq");
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    PrefetchingResultSet rows(*cursor, 8);
+    int64_t count = 1;
+
+    EXPECT_THROW({
+        while (rows.next()) {
+            count++;
+        }
+    }, std::logic_error);
+
+    // The rows of the failed batch are discarded
+    EXPECT_EQ(count, 48);
+    EXPECT_FALSE(rows.pending());
+
+    select->reset();
+}
+
+TEST_F(SQLiteDatabaseTest, PrefetchedValuesMatchSourceValues) {
+    database_->execute_script("CREATE TABLE test(amount NUMERIC, value);"
+                              "INSERT INTO test VALUES(NULL, 1);"
+                              "INSERT INTO test VALUES(7, 2.5);"
+                              "INSERT INTO test VALUES(3.75, 9007199254740993);"
+                              "INSERT INTO test VALUES(9007199254740993, NULL);");
+
+    auto describe = [](const ResultSet& row) {
+        std::vector<std::string> values;
+
+        for (column_t column = 0; column < 2; column++) {
+            switch (row.data_type(column)) {
+                case ResultSet::DataType::INTEGER:
+                    values.push_back("INTEGER " + std::to_string(row.int64(column)));
+                    break;
+                case ResultSet::DataType::FLOAT:
+                    values.push_back("FLOAT " + std::to_string(row.dbl(column)));
+                    break;
+                case ResultSet::DataType::NULL_VALUE:
+                    values.push_back("NULL");
+                    break;
+                default:
+                    values.push_back("OTHER");
+                    break;
+            }
+        }
+
+        return values;
+    };
+
+    auto select = database_->create_statement("SELECT amount, value FROM test ORDER BY rowid");
+    std::vector<std::vector<std::string>> expected;
+
+    for (auto& row : select->rows()) {
+        expected.push_back(describe(row));
+    }
+
+    ASSERT_EQ(expected.size(), 4);
+    EXPECT_EQ(expected[1][0], "INTEGER 7");
+
+    select->reset();
+    auto cursor = select->query();
+    ASSERT_TRUE(cursor);
+
+    std::vector<std::vector<std::string>> prefetched;
+
+    {
+        PrefetchingResultSet rows(*cursor, 2);
+
+        for (; rows.pending(); rows.next()) {
+            prefetched.push_back(describe(rows));
+
+            // Integers above 2^53 aren't rounded
+            if (prefetched.size() == 4) {
+                EXPECT_EQ(rows.int64(0), 9007199254740993);
+            }
+        }
+    }
+
+    EXPECT_EQ(prefetched, expected);
+
+    select->reset();
+}
+
+TEST_F(SQLiteDatabaseTest, ReadConcurrentlyFromConnectionPool) {
+    constexpr size_t THREADS = 4;
+    constexpr int64_t ROWS = 1000;
+    const std::string filename = "pool.db";
+    std::remove(filename.c_str());
+
+    SQLiteConnectionPool pool(filename, THREADS);
+
+    {
+        auto lease = pool.acquire();
+        EXPECT_EQ(lease->create_statement("PRAGMA journal_mode")->query_scalar<std::string>(),
+                "wal");
+
+        lease->execute_script(
+                "CREATE TABLE numbers (n INTEGER);"
+                "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 1000)"
+                "INSERT INTO numbers SELECT n FROM seq;");
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int64_t> sums(THREADS * 2);
+
+    for (size_t i = 0; i < THREADS * 2; i++) {
+        threads.emplace_back([&pool, &sums, i] {
+            auto lease = pool.acquire();
+            auto statement = lease->create_statement("SELECT sum(n) FROM numbers");
+            sums[i] = statement->query_scalar<int64_t>().value_or(0);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto sum : sums) {
+        EXPECT_EQ(sum, ROWS * (ROWS + 1) / 2);
+    }
+
+    EXPECT_EQ(pool.idle(), THREADS);
+    EXPECT_EQ(pool.wait_stats().acquisitions, THREADS * 2 + 1);
+
+    std::remove(filename.c_str());
+    std::remove((filename + "-wal").c_str());
+    std::remove((filename + "-shm").c_str());
+}
+
+TEST_F(SQLiteDatabaseTest, ReleasingLeaseInvalidatesStatements) {
+    const std::string filename = "pool.db";
+    std::remove(filename.c_str());
+
+    SQLiteDatabase::OpenOptions options;
+    options.mode = SQLiteDatabase::SQLiteMode::CREATE;
+
+    SQLiteTuning tuning;
+    tuning.busy_timeout = std::chrono::milliseconds(250);
+
+    SQLiteConnectionPool pool(filename, 1, options, tuning);
+    auto lease = pool.acquire();
+    lease->execute_script("CREATE TABLE numbers (n INTEGER); INSERT INTO numbers VALUES (1), (2);");
+
+    EXPECT_EQ(lease->create_statement("PRAGMA busy_timeout")->query_scalar<int64_t>(), 250);
+
+    auto statement = lease->create_statement("SELECT n FROM numbers");
+    auto cursor = statement->query();
+    ASSERT_TRUE(cursor);
+
+    lease.release();
+
+    // The statement and its cursor outlive the lease, but they no longer
+    // touch the connection
+    EXPECT_FALSE(cursor->next());
+    EXPECT_THROW(statement->execute(), std::logic_error);
+
+    lease = pool.acquire();
+    statement = lease->create_statement("SELECT n FROM numbers");
+    EXPECT_EQ(statement->query_scalar<int64_t>(), 1);
+
+    statement.reset();
+    lease.release();
+
+    std::remove(filename.c_str());
+    std::remove((filename + "-wal").c_str());
+    std::remove((filename + "-shm").c_str());
+}
+
+TEST_F(SQLiteDatabaseTest, ApplyTuningProfilesWhenOpeningDatabase) {
+    const std::string filename = "tuned.db";
+
+    for (auto profile : {SQLiteTuning::Profile::DURABLE, SQLiteTuning::Profile::THROUGHPUT,
+                         SQLiteTuning::Profile::BULK_LOAD}) {
+        std::remove(filename.c_str());
+
+        auto tuning = SQLiteTuning::preset(profile);
+        auto database = std::make_shared<SQLiteDatabase>(filename,
+                SQLiteDatabase::SQLiteMode::CREATE, tuning);
+
+        auto statement = database->create_statement("PRAGMA cache_size");
+        EXPECT_EQ(statement->query_scalar<int64_t>(), tuning.cache_size);
+
+        statement = database->create_statement("PRAGMA synchronous");
+        EXPECT_EQ(statement->query_scalar<int64_t>(),
+                static_cast<int64_t>(tuning.synchronous) - 1);
+
+        database->execute_script("CREATE TABLE numbers (n INTEGER); INSERT INTO numbers VALUES (1);");
+        EXPECT_TRUE(database->has_table("numbers"));
+    }
+
+    auto tuning = SQLiteTuning::preset(SQLiteTuning::Profile::READ_ONLY_ANALYTICS);
+    auto database = std::make_shared<SQLiteDatabase>(filename,
+            SQLiteDatabase::SQLiteMode::READ_ONLY, tuning);
+
+    auto statement = database->create_statement("PRAGMA temp_store");
+    EXPECT_EQ(statement->query_scalar<int64_t>(), 2);
+
+    database.reset();
+    statement.reset();
+
+    std::remove(filename.c_str());
+    std::remove((filename + "-wal").c_str());
+    std::remove((filename + "-shm").c_str());
+}
+
+TEST_F(SQLiteDatabaseTest, SetPageSizeOfNewDatabase) {
+    SQLiteTuning tuning;
+    tuning.page_size = 8192;
+
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db",
+            SQLiteDatabase::SQLiteMode::CREATE, tuning);
+
+    auto statement = database->create_statement("PRAGMA page_size");
+    EXPECT_EQ(statement->query_scalar<int64_t>(), 8192);
+}
+
+TEST_F(SQLiteDatabaseTest, TuningNotTakingEffectThrowsException) {
+    auto tuning = SQLiteTuning::preset(SQLiteTuning::Profile::THROUGHPUT);
+
+    // In-memory databases can't use the WAL mode
+    EXPECT_THROW(SQLiteDatabase(":memory:", SQLiteDatabase::SQLiteMode::IN_MEMORY, tuning),
+            std::invalid_argument);
+}
+
 TEST_F(SQLiteDatabaseTest, CheckIfTableExists) {
     EXPECT_FALSE(database_->has_table("test"));
 
@@ -20,6 +20,7 @@
  * SOFTWARE.
  */
 
+#include <cstdarg>
 #include <stdexcept>
 #include <memory>
 
@@ -59,12 +60,32 @@ int sqlite3_close(sqlite3* db) {
     return mock.sqlite3_close(db);
 }
 
+// Only the lookaside option, which takes a buffer, its slot size and its
+// number of slots, is supported
+int sqlite3_db_config(sqlite3* db, int op, ...) {
+    va_list args;
+    va_start(args, op);
+    auto* buffer = va_arg(args, void*);
+    int size = va_arg(args, int);
+    int count = va_arg(args, int);
+    va_end(args);
+
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_db_config(db, op, buffer, size, count);
+}
+
 int sqlite3_prepare_v2(sqlite3* db, const char* sql, int byte, sqlite3_stmt** stmt,
         const char** tail) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_prepare_v2(db, sql, byte, stmt, tail);
 }
 
+int sqlite3_prepare_v3(sqlite3* db, const char* sql, int byte, unsigned int flags,
+        sqlite3_stmt** stmt, const char** tail) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_prepare_v3(db, sql, byte, flags, stmt, tail);
+}
+
 int sqlite3_finalize(sqlite3_stmt* stmt) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_finalize(stmt);
@@ -76,11 +97,51 @@ int sqlite3_exec(sqlite3* db, const char* sql,
     return mock.sqlite3_exec(db, sql, callback, arg, errmsg);
 }
 
+int sqlite3_get_autocommit(sqlite3* db) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_get_autocommit(db);
+}
+
+const char* sqlite3_errmsg(sqlite3* db) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_errmsg(db);
+}
+
+int sqlite3_changes(sqlite3* db) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_changes(db);
+}
+
 int sqlite3_step(sqlite3_stmt* stmt) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_step(stmt);
 }
 
+int sqlite3_reset(sqlite3_stmt* stmt) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_reset(stmt);
+}
+
+int sqlite3_clear_bindings(sqlite3_stmt* stmt) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_clear_bindings(stmt);
+}
+
+int sqlite3_bind_parameter_count(sqlite3_stmt* stmt) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_bind_parameter_count(stmt);
+}
+
+const char* sqlite3_bind_parameter_name(sqlite3_stmt* stmt, int index) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_bind_parameter_name(stmt, index);
+}
+
+int sqlite3_bind_null(sqlite3_stmt* stmt, int col) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_bind_null(stmt, col);
+}
+
 int sqlite3_bind_int(sqlite3_stmt* stmt, int col, int value) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_bind_int(stmt, col, value);
@@ -108,11 +169,41 @@ int sqlite3_bind_blob(sqlite3_stmt* stmt, int col, const void* blob, int len,
     return mock.sqlite3_bind_blob(stmt, col, blob, len, ptr);
 }
 
+int sqlite3_bind_zeroblob64(sqlite3_stmt* stmt, int col, sqlite3_uint64 len) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_bind_zeroblob64(stmt, col, len);
+}
+
+int sqlite3_column_count(sqlite3_stmt* stmt) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_column_count(stmt);
+}
+
 int sqlite3_column_type(sqlite3_stmt* stmt, int col) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_column_type(stmt, col);
 }
 
+const char* sqlite3_column_decltype(sqlite3_stmt* stmt, int col) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_column_decltype(stmt, col);
+}
+
+const char* sqlite3_column_name(sqlite3_stmt* stmt, int col) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_column_name(stmt, col);
+}
+
+const char* sqlite3_column_table_name(sqlite3_stmt* stmt, int col) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_column_table_name(stmt, col);
+}
+
+const char* sqlite3_column_origin_name(sqlite3_stmt* stmt, int col) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_column_origin_name(stmt, col);
+}
+
 int sqlite3_column_int(sqlite3_stmt* stmt, int col) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_column_int(stmt, col);
@@ -142,3 +233,34 @@ int sqlite3_column_bytes(sqlite3_stmt* stmt, int col) {
     SQLite3Mock& mock = SQLite3Mock::instance();
     return mock.sqlite3_column_bytes(stmt, col);
 }
+
+int sqlite3_blob_open(sqlite3* db, const char* database, const char* table, const char* column,
+        sqlite3_int64 row, int flags, sqlite3_blob** blob) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_open(db, database, table, column, row, flags, blob);
+}
+
+int sqlite3_blob_close(sqlite3_blob* blob) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_close(blob);
+}
+
+int sqlite3_blob_bytes(sqlite3_blob* blob) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_bytes(blob);
+}
+
+int sqlite3_blob_read(sqlite3_blob* blob, void* data, int len, int offset) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_read(blob, data, len, offset);
+}
+
+int sqlite3_blob_write(sqlite3_blob* blob, const void* data, int len, int offset) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_write(blob, data, len, offset);
+}
+
+int sqlite3_blob_reopen(sqlite3_blob* blob, sqlite3_int64 row) {
+    SQLite3Mock& mock = SQLite3Mock::instance();
+    return mock.sqlite3_blob_reopen(blob, row);
+}
@@ -86,22 +86,44 @@ public:
 
     MOCK_METHOD(int, sqlite3_open_v2, (const char*, sqlite3**, int, const char*));
     MOCK_METHOD(int, sqlite3_close, (sqlite3*));
+    MOCK_METHOD(int, sqlite3_db_config, (sqlite3*, int, void*, int, int));
     MOCK_METHOD(int, sqlite3_prepare_v2, (sqlite3*, const char*, int, sqlite3_stmt**, const char**));
+    MOCK_METHOD(int, sqlite3_prepare_v3, (sqlite3*, const char*, int, unsigned int, sqlite3_stmt**, const char**));
     MOCK_METHOD(int, sqlite3_finalize, (sqlite3_stmt*));
     MOCK_METHOD(int, sqlite3_exec, (sqlite3*, const char*, int (*)(void*,int,char**,char**), void*, char**));
+    MOCK_METHOD(int, sqlite3_get_autocommit, (sqlite3*));
+    MOCK_METHOD(const char*, sqlite3_errmsg, (sqlite3*));
+    MOCK_METHOD(int, sqlite3_changes, (sqlite3*));
     MOCK_METHOD(int, sqlite3_step, (sqlite3_stmt*));
+    MOCK_METHOD(int, sqlite3_reset, (sqlite3_stmt*));
+    MOCK_METHOD(int, sqlite3_clear_bindings, (sqlite3_stmt*));
+    MOCK_METHOD(int, sqlite3_bind_parameter_count, (sqlite3_stmt*));
+    MOCK_METHOD(const char*, sqlite3_bind_parameter_name, (sqlite3_stmt*, int));
+    MOCK_METHOD(int, sqlite3_bind_null, (sqlite3_stmt*, int));
     MOCK_METHOD(int, sqlite3_bind_int, (sqlite3_stmt*, int, int));
     MOCK_METHOD(int, sqlite3_bind_int64, (sqlite3_stmt*, int, sqlite3_int64));
     MOCK_METHOD(int, sqlite3_bind_double, (sqlite3_stmt*, int, double));
     MOCK_METHOD(int, sqlite3_bind_text, (sqlite3_stmt*, int, const char*, int, void (*)(void*)));
     MOCK_METHOD(int, sqlite3_bind_blob, (sqlite3_stmt*, int, const void*, int, void (*)(void*)));
+    MOCK_METHOD(int, sqlite3_bind_zeroblob64, (sqlite3_stmt*, int, sqlite3_uint64));
+    MOCK_METHOD(int, sqlite3_column_count, (sqlite3_stmt*));
     MOCK_METHOD(int, sqlite3_column_type, (sqlite3_stmt*, int));
+    MOCK_METHOD(const char*, sqlite3_column_decltype, (sqlite3_stmt*, int));
+    MOCK_METHOD(const char*, sqlite3_column_name, (sqlite3_stmt*, int));
+    MOCK_METHOD(const char*, sqlite3_column_table_name, (sqlite3_stmt*, int));
+    MOCK_METHOD(const char*, sqlite3_column_origin_name, (sqlite3_stmt*, int));
     MOCK_METHOD(int, sqlite3_column_int, (sqlite3_stmt*, int));
     MOCK_METHOD(sqlite3_int64, sqlite3_column_int64, (sqlite3_stmt*, int));
     MOCK_METHOD(double, sqlite3_column_double, (sqlite3_stmt*, int));
     MOCK_METHOD(const unsigned char*, sqlite3_column_text, (sqlite3_stmt*, int));
     MOCK_METHOD(const void*, sqlite3_column_blob, (sqlite3_stmt*, int));
     MOCK_METHOD(int, sqlite3_column_bytes, (sqlite3_stmt*, int));
+    MOCK_METHOD(int, sqlite3_blob_open, (sqlite3*, const char*, const char*, const char*, sqlite3_int64, int, sqlite3_blob**));
+    MOCK_METHOD(int, sqlite3_blob_close, (sqlite3_blob*));
+    MOCK_METHOD(int, sqlite3_blob_bytes, (sqlite3_blob*));
+    MOCK_METHOD(int, sqlite3_blob_read, (sqlite3_blob*, void*, int, int));
+    MOCK_METHOD(int, sqlite3_blob_write, (sqlite3_blob*, const void*, int, int));
+    MOCK_METHOD(int, sqlite3_blob_reopen, (sqlite3_blob*, sqlite3_int64));
 };
 
 } // namespace cppdbc
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cppdbc/sqlite/sqlite_database.hpp"
+#include "sqlite/sqlite_blob_stream.hpp"
+#include "mock/sqlite3_mock.hpp"
+
+using ::testing::DoAll;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::StrEq;
+using ::testing::_; // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+namespace cppdbc {
+
+class SQLiteBlobStreamTest : public ::testing::Test {
+protected:
+    static constexpr int BLOB_SIZE = 16;
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    sqlite3* fake_sqlite_{nullptr};
+    sqlite3_blob* fake_blob_{nullptr};
+
+    std::shared_ptr<SQLite3Mock> mock_;
+    std::shared_ptr<SQLiteDatabase> database_;
+    std::shared_ptr<SQLiteBlobStream> stream_;
+};
+
+void SQLiteBlobStreamTest::SetUp() {
+    mock_ = std::make_shared<NiceMock<SQLite3Mock>>();
+    SQLite3Mock::register_mock(mock_);
+
+    fake_sqlite_ = reinterpret_cast<sqlite3*>(new int(1));
+    fake_blob_ = reinterpret_cast<sqlite3_blob*>(new int(2));
+
+    ON_CALL(*mock_, sqlite3_open_v2)
+            .WillByDefault(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    ON_CALL(*mock_, sqlite3_blob_open)
+            .WillByDefault(DoAll(SetArgPointee<6>(fake_blob_), Return(SQLITE_OK)));
+
+    ON_CALL(*mock_, sqlite3_blob_bytes(fake_blob_)).WillByDefault(Return(BLOB_SIZE));
+
+    database_ = std::make_shared<SQLiteDatabase>("tmp.db");
+    stream_ = std::make_shared<SQLiteBlobStream>(database_, "test", "data", 1, true);
+}
+
+void SQLiteBlobStreamTest::TearDown() {
+    stream_.reset();
+    database_.reset();
+
+    delete reinterpret_cast<int*>(fake_blob_);
+    delete reinterpret_cast<int*>(fake_sqlite_);
+    SQLite3Mock::destroy();
+}
+
+TEST_F(SQLiteBlobStreamTest, ConstructorOpensBlob) {
+    EXPECT_CALL(*mock_, sqlite3_blob_open(fake_sqlite_, StrEq("main"), StrEq("test"),
+            StrEq("data"), 5, 0, _))
+            .WillOnce(DoAll(SetArgPointee<6>(fake_blob_), Return(SQLITE_OK)));
+
+    SQLiteBlobStream stream(database_, "test", "data", 5, false);
+    EXPECT_EQ(stream.size(), BLOB_SIZE);
+}
+
+TEST_F(SQLiteBlobStreamTest, ConstructorWithInvalidDatabaseThrowsException) {
+    EXPECT_THROW(SQLiteBlobStream(nullptr, "test", "data", 1, false), std::invalid_argument);
+}
+
+TEST_F(SQLiteBlobStreamTest, ConstructorWithInvalidRowThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_blob_open).WillOnce(Return(SQLITE_ERROR));
+
+    EXPECT_THROW(SQLiteBlobStream(database_, "test", "data", 1, false), std::invalid_argument);
+}
+
+TEST_F(SQLiteBlobStreamTest, DestructorClosesBlob) {
+    EXPECT_CALL(*mock_, sqlite3_blob_close(fake_blob_));
+    stream_.reset();
+}
+
+TEST_F(SQLiteBlobStreamTest, MoveStreamDoNotCloseBlob) {
+    EXPECT_CALL(*mock_, sqlite3_blob_close).Times(0);
+
+    SQLiteBlobStream stream(std::move(*stream_));
+    EXPECT_EQ(stream.size(), BLOB_SIZE);
+    EXPECT_EQ(stream_->size(), 0);
+
+    testing::Mock::VerifyAndClearExpectations(mock_.get());
+    EXPECT_CALL(*mock_, sqlite3_blob_close(fake_blob_));
+}
+
+TEST_F(SQLiteBlobStreamTest, ReadChunk) {
+    char data[4];
+
+    EXPECT_CALL(*mock_, sqlite3_blob_read(fake_blob_, data, 4, 12)).WillOnce(Return(SQLITE_OK));
+
+    stream_->read(12, data, 4);
+}
+
+TEST_F(SQLiteBlobStreamTest, ReadChunkOutOfBlobThrowsException) {
+    char data[4];
+
+    EXPECT_CALL(*mock_, sqlite3_blob_read).Times(0);
+
+    EXPECT_THROW(stream_->read(13, data, 4), std::invalid_argument);
+    EXPECT_THROW(stream_->read(BLOB_SIZE + 1, data, 0), std::invalid_argument);
+}
+
+TEST_F(SQLiteBlobStreamTest, ReadChunkThrowsExceptionWhenFailure) {
+    char data[4];
+
+    EXPECT_CALL(*mock_, sqlite3_blob_read).WillOnce(Return(SQLITE_ABORT));
+
+    EXPECT_THROW(stream_->read(0, data, 4), std::logic_error);
+}
+
+TEST_F(SQLiteBlobStreamTest, WriteChunk) {
+    const char data[4] = {1, 2, 3, 4};
+
+    EXPECT_CALL(*mock_, sqlite3_blob_write(fake_blob_, data, 4, 0)).WillOnce(Return(SQLITE_OK));
+
+    stream_->write(0, data, 4);
+}
+
+TEST_F(SQLiteBlobStreamTest, WriteChunkOutOfBlobThrowsException) {
+    const char data[4] = {1, 2, 3, 4};
+
+    EXPECT_CALL(*mock_, sqlite3_blob_write).Times(0);
+
+    EXPECT_THROW(stream_->write(14, data, 4), std::invalid_argument);
+}
+
+TEST_F(SQLiteBlobStreamTest, WriteReadOnlyBlobThrowsException) {
+    const char data[4] = {1, 2, 3, 4};
+    SQLiteBlobStream stream(database_, "test", "data", 1, false);
+
+    EXPECT_CALL(*mock_, sqlite3_blob_write).Times(0);
+
+    EXPECT_THROW(stream.write(0, data, 4), std::logic_error);
+}
+
+TEST_F(SQLiteBlobStreamTest, ReopenMovesStreamToRow) {
+    EXPECT_CALL(*mock_, sqlite3_blob_reopen(fake_blob_, 7)).WillOnce(Return(SQLITE_OK));
+    EXPECT_CALL(*mock_, sqlite3_blob_bytes(fake_blob_)).WillOnce(Return(32));
+
+    stream_->reopen(7);
+    EXPECT_EQ(stream_->size(), 32);
+}
+
+TEST_F(SQLiteBlobStreamTest, ReopenWithInvalidRowThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_blob_reopen).WillOnce(Return(SQLITE_ERROR));
+
+    EXPECT_THROW(stream_->reopen(7), std::invalid_argument);
+    EXPECT_EQ(stream_->size(), 0);
+}
+
+} // namespace cppdbc
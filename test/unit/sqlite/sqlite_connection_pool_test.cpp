@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "cppdbc/sqlite/sqlite_connection_pool.hpp"
+#include "mock/sqlite3_mock.hpp"
+
+using ::testing::AnyNumber;
+using ::testing::DoAll;
+using ::testing::HasSubstr;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::StrEq;
+using ::testing::_; // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+namespace cppdbc {
+
+class SQLiteConnectionPoolTest : public ::testing::Test {
+protected:
+    static constexpr size_t POOL_SIZE = 3;
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    sqlite3* fake_sqlite_{nullptr};
+    sqlite3_stmt* read_statement_{nullptr};
+
+    std::shared_ptr<SQLite3Mock> mock_;
+    std::unique_ptr<SQLiteConnectionPool> pool_;
+};
+
+void SQLiteConnectionPoolTest::SetUp() {
+    mock_ = std::make_shared<NiceMock<SQLite3Mock>>();
+    SQLite3Mock::register_mock(mock_);
+
+    fake_sqlite_ = reinterpret_cast<sqlite3*>(new int(1));
+    read_statement_ = reinterpret_cast<sqlite3_stmt*>(new int(2));
+
+    ON_CALL(*mock_, sqlite3_open_v2)
+            .WillByDefault(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    // The busy timeout is read back after it's set
+    ON_CALL(*mock_, sqlite3_prepare_v2(_, StrEq("PRAGMA busy_timeout;"), _, _, _))
+            .WillByDefault(DoAll(SetArgPointee<3>(read_statement_), Return(SQLITE_OK)));
+    ON_CALL(*mock_, sqlite3_step(read_statement_)).WillByDefault(Return(SQLITE_ROW));
+    ON_CALL(*mock_, sqlite3_column_text(read_statement_, 0))
+            .WillByDefault(Return(reinterpret_cast<const unsigned char*>("5000")));
+
+    pool_ = std::make_unique<SQLiteConnectionPool>("tmp.db", POOL_SIZE);
+}
+
+void SQLiteConnectionPoolTest::TearDown() {
+    pool_.reset();
+
+    delete reinterpret_cast<int*>(read_statement_);
+    delete reinterpret_cast<int*>(fake_sqlite_);
+    SQLite3Mock::destroy();
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorOpensAllConnections) {
+    pool_.reset();
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2).Times(POOL_SIZE)
+            .WillRepeatedly(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, _, _, _, _)).Times(AnyNumber());
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, HasSubstr("journal_mode = WAL"), _, _, _)).Times(1);
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, StrEq("PRAGMA busy_timeout = 5000;"), _, _, _))
+            .Times(POOL_SIZE);
+
+    pool_ = std::make_unique<SQLiteConnectionPool>("tmp.db", POOL_SIZE);
+
+    EXPECT_EQ(pool_->size(), POOL_SIZE);
+    EXPECT_EQ(pool_->idle(), POOL_SIZE);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorOpensConnectionsInSerializedMode) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READWRITE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_CREATE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_FULLMUTEX);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, sqlite_flags, _))
+            .WillOnce(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    SQLiteConnectionPool pool("tmp.db", 1);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorOpensConnectionsInMultiThreadModeWhenOptedIn) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READWRITE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_CREATE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_NOMUTEX);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, sqlite_flags, _))
+            .WillOnce(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    SQLiteDatabase::OpenOptions options;
+    options.mode = SQLiteDatabase::SQLiteMode::CREATE;
+    options.threading = SQLiteDatabase::ThreadingMode::MULTI_THREAD;
+
+    SQLiteConnectionPool pool("tmp.db", 1, options);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorOpensConnectionsWithOptions) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READWRITE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_FULLMUTEX)
+                            | static_cast<uint32_t>(SQLITE_OPEN_URI);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, sqlite_flags, _))
+            .WillOnce(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    SQLiteDatabase::OpenOptions options;
+    options.mode = SQLiteDatabase::SQLiteMode::READ_WRITE;
+    options.threading = SQLiteDatabase::ThreadingMode::SERIALIZED;
+    options.uri = true;
+
+    SQLiteConnectionPool pool("file:tmp.db", 1, options);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorTunesConnections) {
+    ON_CALL(*mock_, sqlite3_column_text(read_statement_, 0))
+            .WillByDefault(Return(reinterpret_cast<const unsigned char*>("100")));
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, _, _, _, _)).Times(AnyNumber());
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, StrEq("PRAGMA busy_timeout = 100;"), _, _, _))
+            .Times(2);
+
+    SQLiteTuning tuning;
+    tuning.busy_timeout = std::chrono::milliseconds(100);
+
+    SQLiteConnectionPool pool("tmp.db", 2, SQLiteDatabase::OpenOptions{}, tuning);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorWithTuningFailureThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_text(read_statement_, 0))
+            .WillByDefault(Return(reinterpret_cast<const unsigned char*>("0")));
+
+    EXPECT_THROW(SQLiteConnectionPool("tmp.db", 1), std::invalid_argument);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorInReadOnlyModeDoesNotSetJournalMode) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, _, _, _, _)).Times(AnyNumber());
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(_, HasSubstr("journal_mode"), _, _, _)).Times(0);
+
+    SQLiteConnectionPool pool("tmp.db", 1, SQLiteDatabase::SQLiteMode::READ_ONLY);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorWithInvalidSizeThrowsException) {
+    EXPECT_THROW(SQLiteConnectionPool("tmp.db", 0), std::invalid_argument);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorInMemoryThrowsException) {
+    EXPECT_THROW(SQLiteConnectionPool("tmp.db", 1, SQLiteDatabase::SQLiteMode::IN_MEMORY),
+            std::invalid_argument);
+}
+
+TEST_F(SQLiteConnectionPoolTest, ConstructorWithFailureToOpenThrowsException) {
+    ON_CALL(*mock_, sqlite3_open_v2).WillByDefault(Return(SQLITE_CANTOPEN));
+
+    EXPECT_THROW(SQLiteConnectionPool("tmp.db", 1), std::invalid_argument);
+}
+
+TEST_F(SQLiteConnectionPoolTest, LeaseReturnsConnectionWhenDestroyed) {
+    {
+        auto lease = pool_->acquire();
+        EXPECT_TRUE(lease);
+        EXPECT_TRUE(lease->valid());
+        EXPECT_EQ(pool_->idle(), POOL_SIZE - 1);
+    }
+
+    EXPECT_EQ(pool_->idle(), POOL_SIZE);
+}
+
+TEST_F(SQLiteConnectionPoolTest, MovedLeaseKeepsConnection) {
+    auto lease = pool_->acquire();
+    auto other = std::move(lease);
+
+    EXPECT_FALSE(lease); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    EXPECT_TRUE(other);
+    EXPECT_EQ(pool_->idle(), POOL_SIZE - 1);
+
+    other.release();
+    EXPECT_FALSE(other);
+    EXPECT_THROW(*other, std::logic_error);
+    EXPECT_EQ(pool_->idle(), POOL_SIZE);
+}
+
+TEST_F(SQLiteConnectionPoolTest, AcquireReturnsConnectionLastLeasedByThread) {
+    SQLiteDatabase* database;
+
+    {
+        auto first = pool_->acquire();
+        auto second = pool_->acquire();
+        database = &*first;
+    }
+
+    auto lease = pool_->acquire();
+
+    EXPECT_EQ(&*lease, database);
+    EXPECT_EQ(pool_->wait_stats().acquisitions, 3);
+    EXPECT_GE(pool_->wait_stats().affine, 1);
+}
+
+TEST_F(SQLiteConnectionPoolTest, TryAcquireTimesOutWhenAllConnectionsAreLeased) {
+    std::vector<SQLiteConnectionPool::Lease> leases;
+
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        leases.push_back(pool_->acquire());
+    }
+
+    EXPECT_FALSE(pool_->try_acquire(std::chrono::milliseconds(1)));
+
+    auto stats = pool_->wait_stats();
+    EXPECT_EQ(stats.acquisitions, POOL_SIZE);
+    EXPECT_EQ(stats.waits, 1);
+    EXPECT_EQ(stats.timeouts, 1);
+}
+
+TEST_F(SQLiteConnectionPoolTest, AcquireWaitsForReleasedConnection) {
+    std::vector<SQLiteConnectionPool::Lease> leases;
+
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        leases.push_back(pool_->acquire());
+    }
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        leases.pop_back();
+    });
+
+    auto lease = pool_->try_acquire(std::chrono::seconds(5));
+    releaser.join();
+
+    ASSERT_TRUE(lease);
+    auto stats = pool_->wait_stats();
+    EXPECT_EQ(stats.waits, 1);
+    EXPECT_EQ(stats.timeouts, 0);
+    EXPECT_GT(stats.total_wait.count(), 0);
+    EXPECT_EQ(stats.max_wait, stats.total_wait);
+}
+
+TEST_F(SQLiteConnectionPoolTest, LeaseOutlivesPool) {
+    auto lease = pool_->acquire();
+    pool_.reset();
+
+    EXPECT_TRUE(lease->valid());
+}
+
+} // namespace cppdbc
@@ -27,6 +27,7 @@
 
 using ::testing::AtLeast;
 using ::testing::DoAll;
+using ::testing::Mock;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::SetArgPointee;
@@ -60,6 +61,9 @@ void SQLiteDatabaseTest::SetUp() {
     ON_CALL(*mock_, sqlite3_prepare_v2)
             .WillByDefault(DoAll(SetArgPointee<3>(fake_statement_), Return(SQLITE_OK)));
 
+    ON_CALL(*mock_, sqlite3_prepare_v3)
+            .WillByDefault(DoAll(SetArgPointee<4>(fake_statement_), Return(SQLITE_OK)));
+
     database_ = std::make_shared<SQLiteDatabase>("tmp.db");
 }
 
@@ -118,6 +122,60 @@ TEST_F(SQLiteDatabaseTest, CreateDatabaseInMemoryMode) {
     EXPECT_TRUE(database->valid());
 }
 
+TEST_F(SQLiteDatabaseTest, CreateDatabaseInMultiThreadMode) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READWRITE)
+                            | static_cast<uint32_t>(SQLITE_OPEN_NOMUTEX);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, sqlite_flags, _));
+
+    SQLiteDatabase::OpenOptions options;
+    options.mode = SQLiteDatabase::SQLiteMode::READ_WRITE;
+    options.threading = SQLiteDatabase::ThreadingMode::MULTI_THREAD;
+
+    std::make_shared<SQLiteDatabase>("tmp.db", options);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateDatabaseInSerializedMode) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READONLY)
+                            | static_cast<uint32_t>(SQLITE_OPEN_FULLMUTEX);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, sqlite_flags, _));
+
+    SQLiteDatabase::OpenOptions options;
+    options.threading = SQLiteDatabase::ThreadingMode::SERIALIZED;
+
+    std::make_shared<SQLiteDatabase>("tmp.db", options);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateDatabaseWithCacheMode) {
+    uint32_t private_flags = static_cast<uint32_t>(SQLITE_OPEN_READONLY)
+                             | static_cast<uint32_t>(SQLITE_OPEN_PRIVATECACHE);
+    uint32_t shared_flags = static_cast<uint32_t>(SQLITE_OPEN_READONLY)
+                            | static_cast<uint32_t>(SQLITE_OPEN_SHAREDCACHE);
+
+    SQLiteDatabase::OpenOptions options;
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, private_flags, _));
+    options.cache = SQLiteDatabase::CacheMode::PRIVATE;
+    std::make_shared<SQLiteDatabase>("tmp.db", options);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(_, _, shared_flags, _));
+    options.cache = SQLiteDatabase::CacheMode::SHARED;
+    std::make_shared<SQLiteDatabase>("tmp.db", options);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateDatabaseFromUri) {
+    uint32_t sqlite_flags = static_cast<uint32_t>(SQLITE_OPEN_READONLY)
+                            | static_cast<uint32_t>(SQLITE_OPEN_URI);
+
+    EXPECT_CALL(*mock_, sqlite3_open_v2(StrEq("file:tmp.db?mode=ro"), _, sqlite_flags, _));
+
+    SQLiteDatabase::OpenOptions options;
+    options.uri = true;
+
+    std::make_shared<SQLiteDatabase>("file:tmp.db?mode=ro", options);
+}
+
 TEST_F(SQLiteDatabaseTest, CreateInvalidDatabaseThrowsExcption) {
     ON_CALL(*mock_, sqlite3_open_v2)
             .WillByDefault(Return(SQLITE_ERROR));
@@ -163,6 +221,89 @@ TEST_F(SQLiteDatabaseTest, CreateStatementFromDatabase) {
     EXPECT_NE(statement, nullptr);
 }
 
+TEST_F(SQLiteDatabaseTest, CreateStatementPreparesPersistentStatement) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3(_, StrEq("SQL"), 3, SQLITE_PREPARE_PERSISTENT, _, _))
+            .WillOnce(DoAll(SetArgPointee<4>(fake_statement_), Return(SQLITE_OK)));
+
+    auto statement = database_->create_statement("SQL");
+    EXPECT_NE(statement, nullptr);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateStatementReusesCachedStatement) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3)
+            .WillOnce(DoAll(SetArgPointee<4>(fake_statement_), Return(SQLITE_OK)));
+
+    auto statement = database_->create_statement("SQL");
+
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_statement_));
+    EXPECT_CALL(*mock_, sqlite3_clear_bindings(fake_statement_));
+    EXPECT_CALL(*mock_, sqlite3_finalize)
+            .Times(0);
+    statement.reset();
+    Mock::VerifyAndClearExpectations(mock_.get());
+
+    statement = database_->create_statement("SQL");
+    EXPECT_NE(statement, nullptr);
+    EXPECT_TRUE(statement->pending());
+
+    auto stats = database_->statement_cache_stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.evictions, 0);
+}
+
+TEST_F(SQLiteDatabaseTest, CreateStatementInUsePreparesNewStatement) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3)
+            .Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<4>(fake_statement_), Return(SQLITE_OK)));
+
+    auto statement1 = database_->create_statement("SQL");
+    auto statement2 = database_->create_statement("SQL");
+
+    EXPECT_EQ(database_->statement_cache_stats().misses, 2);
+}
+
+TEST_F(SQLiteDatabaseTest, StatementCacheEvictsLeastRecentlyUsedStatement) {
+    auto fake_statement = reinterpret_cast<sqlite3_stmt*>(new int(2));
+    database_->set_statement_cache_capacity(1);
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3(_, StrEq("SQL1"), _, _, _, _))
+            .WillOnce(DoAll(SetArgPointee<4>(fake_statement), Return(SQLITE_OK)));
+
+    database_->create_statement("SQL1");
+    Mock::VerifyAndClearExpectations(mock_.get());
+
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_statement));
+    database_->create_statement("SQL2");
+    Mock::VerifyAndClearExpectations(mock_.get());
+
+    EXPECT_EQ(database_->statement_cache_stats().evictions, 1);
+    delete reinterpret_cast<int*>(fake_statement);
+}
+
+TEST_F(SQLiteDatabaseTest, DisabledStatementCacheDoesNotCacheStatements) {
+    database_->set_statement_cache_capacity(0);
+    ASSERT_EQ(database_->statement_cache_capacity(), 0);
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2)
+            .Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<3>(fake_statement_), Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_statement_))
+            .Times(2);
+
+    database_->create_statement("SQL");
+    database_->create_statement("SQL");
+}
+
+TEST_F(SQLiteDatabaseTest, DestructorFinalizesCachedStatements) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db");
+    database->create_statement("SQL");
+
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_statement_));
+    EXPECT_CALL(*mock_, sqlite3_close);
+    database.reset();
+}
+
 TEST_F(SQLiteDatabaseTest, CreateStatementFromInvalidDatabaseThrowsException) {
     ON_CALL(*mock_, sqlite3_open_v2)
             .WillByDefault(DoAll(SetArgPointee<1>(nullptr), Return(SQLITE_OK)));
@@ -171,13 +312,146 @@ TEST_F(SQLiteDatabaseTest, CreateStatementFromInvalidDatabaseThrowsException) {
     EXPECT_THROW(database->create_statement("SQL"), std::logic_error);
 }
 
+TEST_F(SQLiteDatabaseTest, ExecuteScriptExecutesEachStatementInPlace) {
+    const std::string_view script = "STMT1; STMT2;";
+    const char* second = script.data() + 7;
+    const char* end = script.data() + script.size();
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, script.data(), 13, _, _))
+            .WillOnce(DoAll(SetArgPointee<3>(fake_statement_), SetArgPointee<4>(second),
+                    Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, second, 6, _, _))
+            .WillOnce(DoAll(SetArgPointee<3>(fake_statement_), SetArgPointee<4>(end),
+                    Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_statement_))
+            .Times(2)
+            .WillRepeatedly(Return(SQLITE_DONE));
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_statement_)).Times(2);
+
+    database_->execute_script(script);
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteScriptReportsFailingStatement) {
+    const std::string_view script = "STMT1; STMT2;";
+    const char* second = script.data() + 7;
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, script.data(), _, _, _))
+            .WillOnce(DoAll(SetArgPointee<3>(fake_statement_), SetArgPointee<4>(second),
+                    Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, second, _, _, _))
+            .WillOnce(Return(SQLITE_ERROR));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_statement_)).WillOnce(Return(SQLITE_DONE));
+    ON_CALL(*mock_, sqlite3_errmsg).WillByDefault(Return("syntax error"));
+
+    try {
+        database_->execute_script(script);
+        FAIL() << "Expected script_error";
+    } catch (const script_error& e) {
+        EXPECT_EQ(e.statement(), 1);
+        EXPECT_EQ(e.offset(), 7);
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, ExecuteScriptFromInvalidDatabaseThrowsException) {
+    ON_CALL(*mock_, sqlite3_open_v2)
+            .WillByDefault(DoAll(SetArgPointee<1>(nullptr), Return(SQLITE_OK)));
+
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db");
+    EXPECT_THROW(database->execute_script("SQL"), std::logic_error);
+}
+
+TEST_F(SQLiteDatabaseTest, TuneDatabaseAppliesAndVerifiesPragma) {
+    auto* read_statement = reinterpret_cast<sqlite3_stmt*>(new int(2));
+    const char* value = "-2000";
+
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, StrEq("PRAGMA cache_size = -2000;"), _,
+            _, _)).WillOnce(DoAll(SetArgPointee<3>(fake_statement_), Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2(fake_sqlite_, StrEq("PRAGMA cache_size;"), _, _, _))
+            .WillOnce(DoAll(SetArgPointee<3>(read_statement), Return(SQLITE_OK)));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_statement_)).WillOnce(Return(SQLITE_DONE));
+    EXPECT_CALL(*mock_, sqlite3_step(read_statement)).WillOnce(Return(SQLITE_ROW));
+    EXPECT_CALL(*mock_, sqlite3_column_text(read_statement, 0))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(value)));
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_statement_));
+    EXPECT_CALL(*mock_, sqlite3_finalize(read_statement));
+
+    SQLiteTuning tuning;
+    tuning.cache_size = -2000;
+
+    database_->tune(tuning);
+    delete reinterpret_cast<int*>(read_statement);
+}
+
+TEST_F(SQLiteDatabaseTest, TuneDatabaseWithSettingNotTakingEffectThrowsException) {
+    const char* value = "memory";
+
+    // The pragma is set and read back with the same statement
+    EXPECT_CALL(*mock_, sqlite3_step(fake_statement_))
+            .WillOnce(Return(SQLITE_DONE))
+            .WillOnce(Return(SQLITE_ROW));
+    ON_CALL(*mock_, sqlite3_column_text(fake_statement_, 0))
+            .WillByDefault(Return(reinterpret_cast<const unsigned char*>(value)));
+
+    SQLiteTuning tuning;
+    tuning.journal_mode = SQLiteTuning::JournalMode::WAL;
+
+    EXPECT_THROW(database_->tune(tuning), std::invalid_argument);
+}
+
+TEST_F(SQLiteDatabaseTest, TuneDatabaseConfiguresLookaside) {
+    EXPECT_CALL(*mock_, sqlite3_db_config(fake_sqlite_, SQLITE_DBCONFIG_LOOKASIDE, nullptr, 1200,
+            500)).WillOnce(Return(SQLITE_OK));
+
+    SQLiteTuning tuning;
+    tuning.lookaside = SQLiteTuning::Lookaside{1200, 500};
+
+    database_->tune(tuning);
+}
+
+TEST_F(SQLiteDatabaseTest, TuneDatabaseWithLookasideInUseThrowsException) {
+    ON_CALL(*mock_, sqlite3_db_config).WillByDefault(Return(SQLITE_BUSY));
+
+    SQLiteTuning tuning;
+    tuning.lookaside = SQLiteTuning::Lookaside{1200, 500};
+
+    EXPECT_THROW(database_->tune(tuning), std::invalid_argument);
+}
+
+TEST_F(SQLiteDatabaseTest, TuneInvalidDatabaseThrowsException) {
+    ON_CALL(*mock_, sqlite3_open_v2)
+            .WillByDefault(DoAll(SetArgPointee<1>(nullptr), Return(SQLITE_OK)));
+
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db");
+    EXPECT_THROW(database->tune(SQLiteTuning{}), std::logic_error);
+}
+
+TEST_F(SQLiteDatabaseTest, PresetsOfTuningProfiles) {
+    auto durable = SQLiteTuning::preset(SQLiteTuning::Profile::DURABLE);
+    EXPECT_EQ(durable.journal_mode, SQLiteTuning::JournalMode::WAL);
+    EXPECT_EQ(durable.synchronous, SQLiteTuning::Synchronous::FULL);
+
+    auto throughput = SQLiteTuning::preset(SQLiteTuning::Profile::THROUGHPUT);
+    EXPECT_EQ(throughput.journal_mode, SQLiteTuning::JournalMode::WAL);
+    EXPECT_EQ(throughput.synchronous, SQLiteTuning::Synchronous::NORMAL);
+    EXPECT_TRUE(throughput.mmap_size);
+
+    auto bulk_load = SQLiteTuning::preset(SQLiteTuning::Profile::BULK_LOAD);
+    EXPECT_EQ(bulk_load.synchronous, SQLiteTuning::Synchronous::OFF);
+    EXPECT_EQ(bulk_load.temp_store, SQLiteTuning::TempStore::MEMORY);
+
+    auto analytics = SQLiteTuning::preset(SQLiteTuning::Profile::READ_ONLY_ANALYTICS);
+    EXPECT_EQ(analytics.journal_mode, SQLiteTuning::JournalMode::DEFAULT);
+    EXPECT_EQ(analytics.synchronous, SQLiteTuning::Synchronous::DEFAULT);
+    EXPECT_TRUE(analytics.mmap_size);
+}
+
 TEST_F(SQLiteDatabaseTest, CheckIfTableExists) {
     auto database = std::make_shared<SQLiteDatabase>("tmp.db");
 
     ON_CALL(*mock_, sqlite3_step)
             .WillByDefault(Return(SQLITE_ROW));
 
-    ON_CALL(*mock_, sqlite3_column_int)
+    ON_CALL(*mock_, sqlite3_column_int64)
             .WillByDefault(Return(1));
 
     EXPECT_TRUE(database->has_table("test"));
@@ -189,4 +463,14 @@ TEST_F(SQLiteDatabaseTest, CreateTransactionFromDatabase) {
     EXPECT_NE(transaction, nullptr);
 }
 
+TEST_F(SQLiteDatabaseTest, OpenBlobFromDatabase) {
+    auto database = std::make_shared<SQLiteDatabase>("tmp.db");
+
+    EXPECT_CALL(*mock_, sqlite3_blob_open(_, StrEq("main"), StrEq("test"), StrEq("data"), 3, 1, _))
+            .WillOnce(Return(SQLITE_OK));
+
+    auto stream = database->open_blob("test", "data", 3, true);
+    EXPECT_NE(stream, nullptr);
+}
+
 } // namespace cppdbc
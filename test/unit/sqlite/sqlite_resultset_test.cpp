@@ -22,6 +22,7 @@
 
 #include <gtest/gtest.h>
 
+#include "cppdbc/column_batch.hpp"
 #include "cppdbc/sqlite/sqlite_database.hpp"
 #include "sqlite/sqlite_resultset.hpp"
 #include "sqlite/sqlite_statement.hpp"
@@ -32,6 +33,14 @@ using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 
+struct Record {
+    int32_t id;
+    std::string name;
+    double value;
+};
+
+CPPDBC_MAPPING(Record, &Record::id, &Record::name, &Record::value);
+
 namespace cppdbc {
 
 class SQLiteResultSetTest : public ::testing::Test {
@@ -47,6 +56,7 @@ protected:
 
     sqlite3_stmt* fake_stmt_{nullptr};
     std::shared_ptr<SQLiteDatabase> database_;
+    std::shared_ptr<SQLiteStatement> statement_;
     std::shared_ptr<ResultSet> result_set_;
 };
 
@@ -66,14 +76,15 @@ void SQLiteResultSetTest::SetUp() {
             .WillByDefault(Return(SQLITE_INTEGER));
 
     database_ = std::make_shared<SQLiteDatabase>("tmp.db");
-    auto statement = std::make_shared<SQLiteStatement>(database_, "SQL");
-    result_set_ = std::make_shared<SQLiteResultSet>(statement);
+    statement_ = std::make_shared<SQLiteStatement>(database_, "SQL");
+    result_set_ = std::make_shared<SQLiteResultSet>(statement_);
 }
 
 void SQLiteResultSetTest::TearDown() {
     delete reinterpret_cast<int*>(fake_stmt_);
 
     result_set_.reset();
+    statement_.reset();
     SQLite3Mock::destroy();
 }
 
@@ -111,6 +122,22 @@ TEST_F(SQLiteResultSetTest, NextWithInvalidStatementThrowsException) {
     EXPECT_THROW(result_set->next(), std::logic_error);
 }
 
+TEST_F(SQLiteResultSetTest, NextAfterStatementResetReturnsFalse) {
+    ON_CALL(*mock_, sqlite3_step)
+            .WillByDefault(Return(SQLITE_ROW));
+
+    statement_->reset();
+
+    EXPECT_CALL(*mock_, sqlite3_step)
+            .Times(0);
+    EXPECT_FALSE(result_set_->next());
+}
+
+TEST_F(SQLiteResultSetTest, GetValueAfterStatementResetThrowsException) {
+    statement_->reset();
+    EXPECT_THROW(result_set_->int32(0), std::logic_error);
+}
+
 void SQLiteResultSetTest::check_data_type(uint16_t index, uint16_t sqlite_type,
         ResultSet::DataType expected_type) {
 
@@ -136,6 +163,48 @@ TEST_F(SQLiteResultSetTest, GetDataTypeBlob) {
     check_data_type(8, SQLITE_BLOB, ResultSet::DataType::BLOB);
 }
 
+TEST_F(SQLiteResultSetTest, GetDataTypeNull) {
+    check_data_type(3, SQLITE_NULL, ResultSet::DataType::NULL_VALUE);
+}
+
+TEST_F(SQLiteResultSetTest, CheckIfValueIsNull) {
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_NULL));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillOnce(Return(SQLITE_TEXT));
+
+    EXPECT_TRUE(result_set_->is_null(0));
+    EXPECT_TRUE(result_set_->is_null(0));
+    EXPECT_FALSE(result_set_->is_null(1));
+}
+
+TEST_F(SQLiteResultSetTest, GetOptionalFromNullIsEmpty) {
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_NULL));
+    EXPECT_CALL(*mock_, sqlite3_column_int64).Times(0);
+
+    EXPECT_EQ(result_set_->get<std::optional<int64_t>>(0), std::nullopt);
+    EXPECT_EQ(result_set_->get<std::optional<std::string_view>>(0), std::nullopt);
+}
+
+TEST_F(SQLiteResultSetTest, GetOptionalFromValueHasValue) {
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_INTEGER));
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(42));
+
+    EXPECT_EQ(result_set_->get<std::optional<int64_t>>(0), 42);
+}
+
+TEST_F(SQLiteResultSetTest, GetIntegerFromNullThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_NULL));
+
+    EXPECT_THROW(result_set_->int64(0), std::invalid_argument);
+}
+
+TEST_F(SQLiteResultSetTest, GetBlobFromNullIsEmpty) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_NULL));
+
+    EXPECT_TRUE(result_set_->blob_view(0).empty());
+}
+
 TEST_F(SQLiteResultSetTest, GetUnsignedInteger8) {
     EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 2))
             .WillOnce(Return(10));
@@ -270,6 +339,336 @@ TEST_F(SQLiteResultSetTest, GetBlobNoDataReturnsNullptr) {
     EXPECT_EQ(actual, nullptr);
 }
 
+TEST_F(SQLiteResultSetTest, GetTextViewWithoutCopy) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_TEXT));
+
+    const char* expected = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_column_text(fake_stmt_, 2))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(expected)));
+    EXPECT_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 2))
+            .WillOnce(Return(strlen(expected)));
+
+    std::string_view actual = result_set_->text_view(2);
+
+    EXPECT_EQ(actual.data(), expected);
+    EXPECT_EQ(actual.size(), strlen(expected));
+}
+
+TEST_F(SQLiteResultSetTest, GetBlobViewWithoutCopy) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_BLOB));
+
+    const char* expected = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_column_blob(fake_stmt_, 2))
+            .WillOnce(Return(expected));
+    EXPECT_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 2))
+            .WillOnce(Return(strlen(expected)));
+
+    BlobView actual = result_set_->blob_view(2);
+
+    EXPECT_EQ(actual.data(), reinterpret_cast<const std::byte*>(expected));
+    EXPECT_EQ(actual.size(), strlen(expected));
+}
+
+TEST_F(SQLiteResultSetTest, GetBlobViewNoDataReturnsEmptyView) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_BLOB));
+
+    BlobView actual = result_set_->blob_view(2);
+
+    EXPECT_TRUE(actual.empty());
+    EXPECT_EQ(actual.data(), nullptr);
+}
+
+TEST_F(SQLiteResultSetTest, GetTextViewFromDifferentDataTypeThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_type)
+            .WillByDefault(Return(SQLITE_BLOB));
+
+    EXPECT_THROW(result_set_->text_view(0), std::invalid_argument);
+}
+
+TEST_F(SQLiteResultSetTest, ColumnTypeIsGotOncePerRow) {
+    ON_CALL(*mock_, sqlite3_step)
+            .WillByDefault(Return(SQLITE_ROW));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1))
+            .Times(2)
+            .WillRepeatedly(Return(SQLITE_INTEGER));
+
+    result_set_->int32(1);
+    result_set_->int64(1);
+
+    result_set_->next();
+    result_set_->int32(1);
+    result_set_->uint8(1);
+}
+
+TEST_F(SQLiteResultSetTest, ColumnTypeOfWideColumnIsNotCached) {
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 100))
+            .Times(2)
+            .WillRepeatedly(Return(SQLITE_INTEGER));
+
+    result_set_->int32(100);
+    result_set_->int32(100);
+}
+
+TEST_F(SQLiteResultSetTest, GetValueWithoutTypeChecking) {
+    result_set_->set_type_checking(false);
+
+    EXPECT_CALL(*mock_, sqlite3_column_type)
+            .Times(0);
+    EXPECT_CALL(*mock_, sqlite3_column_double(fake_stmt_, 0))
+            .WillOnce(Return(1.5));
+
+    EXPECT_DOUBLE_EQ(result_set_->dbl(0), 1.5);
+}
+
+TEST_F(SQLiteResultSetTest, GetValueWithoutTypeCheckingAfterStatementResetThrowsException) {
+    result_set_->set_type_checking(false);
+    statement_->reset();
+
+    EXPECT_THROW(result_set_->int32(0), std::logic_error);
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchStoresRowsInColumns) {
+    const char* text = "Test";
+
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(2));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    ON_CALL(*mock_, sqlite3_column_text(fake_stmt_, 1))
+            .WillByDefault(Return(reinterpret_cast<const unsigned char*>(text)));
+    ON_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 1)).WillByDefault(Return(4));
+
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0))
+            .WillOnce(Return(1))
+            .WillOnce(Return(2));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    ColumnBatch batch;
+    ASSERT_EQ(result_set_->fetch_batch(batch, 10), 2);
+
+    ASSERT_EQ(batch.columns.size(), 2);
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+    EXPECT_EQ(batch.columns[0].integers, (std::vector<int64_t>{1, 2}));
+    EXPECT_EQ(batch.columns[1].type, ResultSet::DataType::TEXT);
+    EXPECT_EQ(batch.columns[1].text(0), "Test");
+    EXPECT_EQ(batch.columns[1].text(1), "Test");
+    EXPECT_TRUE(batch.columns[1].valid(1));
+
+    EXPECT_EQ(result_set_->fetch_batch(batch, 10), 0);
+    EXPECT_EQ(batch.rows, 0);
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchStopsAtMaximumNumberOfRows) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+    ON_CALL(*mock_, sqlite3_step).WillByDefault(Return(SQLITE_ROW));
+
+    ColumnBatch batch;
+    EXPECT_EQ(result_set_->fetch_batch(batch, 3), 3);
+    EXPECT_EQ(batch.columns[0].integers.size(), 3);
+    EXPECT_EQ(result_set_->fetch_batch(batch, 3), 3);
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchMarksNullValuesAsInvalid) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0))
+            .WillRepeatedly(Return(SQLITE_NULL));
+    EXPECT_CALL(*mock_, sqlite3_column_decltype(fake_stmt_, 0))
+            .WillOnce(Return("double"));
+    EXPECT_CALL(*mock_, sqlite3_column_double).Times(0);
+
+    ColumnBatch batch;
+    ASSERT_EQ(result_set_->fetch_batch(batch, 10), 1);
+
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::FLOAT);
+    EXPECT_FALSE(batch.columns[0].valid(0));
+    EXPECT_EQ(batch.columns[0].reals, std::vector<double>{0.0});
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchPromotesIntegerColumnToFloat) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0))
+            .WillOnce(Return(SQLITE_INTEGER))
+            .WillOnce(Return(SQLITE_FLOAT));
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(1));
+    EXPECT_CALL(*mock_, sqlite3_column_double(fake_stmt_, 0)).WillOnce(Return(2.5));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    ColumnBatch batch;
+    ASSERT_EQ(result_set_->fetch_batch(batch, 10), 2);
+
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::FLOAT);
+    EXPECT_EQ(batch.columns[0].reals, (std::vector<double>{1.0, 2.5}));
+    EXPECT_EQ(batch.columns[0].integers, (std::vector<int64_t>{1, 0}));
+    EXPECT_TRUE(batch.columns[0].has_integer(0));
+    EXPECT_FALSE(batch.columns[0].has_integer(1));
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchNullColumnTakesDataTypeOfFirstValue) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0))
+            .WillOnce(Return(SQLITE_NULL))
+            .WillOnce(Return(SQLITE_INTEGER));
+    EXPECT_CALL(*mock_, sqlite3_column_decltype(fake_stmt_, 0)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(7));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    ColumnBatch batch;
+    ASSERT_EQ(result_set_->fetch_batch(batch, 10), 2);
+
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::INTEGER);
+    EXPECT_EQ(batch.columns[0].integers, (std::vector<int64_t>{0, 7}));
+    EXPECT_EQ(batch.columns[0].offsets.size(), 1);
+    EXPECT_FALSE(batch.columns[0].valid(0));
+    EXPECT_TRUE(batch.columns[0].valid(1));
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchOfNullWithNumericAffinityStoresFloat) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0))
+            .WillRepeatedly(Return(SQLITE_NULL));
+    EXPECT_CALL(*mock_, sqlite3_column_decltype(fake_stmt_, 0))
+            .WillOnce(Return("NUMERIC(10, 2)"));
+
+    ColumnBatch batch;
+    ASSERT_EQ(result_set_->fetch_batch(batch, 10), 1);
+
+    EXPECT_EQ(batch.columns[0].type, ResultSet::DataType::FLOAT);
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchWithTextInIntegerColumnThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0))
+            .WillOnce(Return(SQLITE_INTEGER))
+            .WillOnce(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(1));
+    EXPECT_CALL(*mock_, sqlite3_column_text).Times(0);
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+
+    ColumnBatch batch;
+    EXPECT_THROW(result_set_->fetch_batch(batch, 10), std::invalid_argument);
+}
+
+TEST_F(SQLiteResultSetTest, FetchBatchWithFailureThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(1));
+    ON_CALL(*mock_, sqlite3_step).WillByDefault(Return(SQLITE_ERROR));
+
+    ColumnBatch batch;
+    EXPECT_THROW(result_set_->fetch_batch(batch, 10), std::logic_error);
+}
+
+TEST_F(SQLiteResultSetTest, ReadFieldsInOrder) {
+    int64_t id = 0;
+    uint8_t flag = 0;
+    Field fields[] = {Field(&id), Field(&flag)};
+
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(7));
+    EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 1)).WillOnce(Return(1));
+
+    result_set_->read(fields, 2);
+
+    EXPECT_EQ(id, 7);
+    EXPECT_EQ(flag, 1);
+}
+
+TEST_F(SQLiteResultSetTest, ReadFieldFromDifferentDataTypeThrowsException) {
+    std::string name;
+    Field field(&name);
+
+    EXPECT_THROW(result_set_->read(&field, 1), std::invalid_argument);
+}
+
+TEST_F(SQLiteResultSetTest, ReadNullableFields) {
+    const char* text = "Test";
+    std::optional<int32_t> id = 1;
+    std::optional<std::string> name;
+
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(2));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillByDefault(Return(SQLITE_NULL));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_int).Times(0);
+    EXPECT_CALL(*mock_, sqlite3_column_text(fake_stmt_, 1))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(text)));
+    EXPECT_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 1)).WillOnce(Return(4));
+
+    std::array<Field, 2> fields{Field(&id), Field(&name)};
+    EXPECT_TRUE(fields[0].nullable());
+    result_set_->read(fields.data(), fields.size());
+
+    EXPECT_EQ(id, std::nullopt);
+    EXPECT_EQ(name, "Test");
+}
+
+TEST_F(SQLiteResultSetTest, FetchRowAsMappedType) {
+    const char* text = "Test";
+
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 2)).WillByDefault(Return(SQLITE_FLOAT));
+    EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 0)).WillOnce(Return(3));
+    EXPECT_CALL(*mock_, sqlite3_column_text(fake_stmt_, 1))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(text)));
+    EXPECT_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 1)).WillOnce(Return(4));
+    EXPECT_CALL(*mock_, sqlite3_column_double(fake_stmt_, 2)).WillOnce(Return(0.5));
+
+    auto record = result_set_->fetch_as<Record>();
+
+    EXPECT_EQ(record.id, 3);
+    EXPECT_EQ(record.name, "Test");
+    EXPECT_DOUBLE_EQ(record.value, 0.5);
+}
+
+TEST_F(SQLiteResultSetTest, MetadataIsComputedOnceForStatement) {
+    EXPECT_CALL(*mock_, sqlite3_column_count(fake_stmt_)).WillOnce(Return(2));
+    EXPECT_CALL(*mock_, sqlite3_column_name(fake_stmt_, 0)).WillOnce(Return("id"));
+    EXPECT_CALL(*mock_, sqlite3_column_name(fake_stmt_, 1)).WillOnce(Return("total"));
+    EXPECT_CALL(*mock_, sqlite3_column_decltype(fake_stmt_, 0)).WillOnce(Return("INTEGER"));
+    EXPECT_CALL(*mock_, sqlite3_column_decltype(fake_stmt_, 1)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mock_, sqlite3_column_table_name(fake_stmt_, 0)).WillOnce(Return("users"));
+    EXPECT_CALL(*mock_, sqlite3_column_table_name(fake_stmt_, 1)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mock_, sqlite3_column_origin_name(fake_stmt_, 0)).WillOnce(Return("id"));
+    EXPECT_CALL(*mock_, sqlite3_column_origin_name(fake_stmt_, 1)).WillOnce(Return(nullptr));
+
+    auto metadata = result_set_->metadata();
+    auto other = std::make_shared<SQLiteResultSet>(statement_);
+
+    EXPECT_EQ(other->metadata(), metadata);
+    ASSERT_EQ(metadata->column_count(), 2);
+    EXPECT_EQ(metadata->column(0).name, "id");
+    EXPECT_EQ(metadata->column(0).declared_type, "INTEGER");
+    EXPECT_EQ(metadata->column(0).table, "users");
+    EXPECT_EQ(metadata->column(0).origin, "id");
+    EXPECT_EQ(metadata->column(1).name, "total");
+    EXPECT_TRUE(metadata->column(1).declared_type.empty());
+    EXPECT_TRUE(metadata->column(1).table.empty());
+    EXPECT_THROW((void) metadata->column(2), std::invalid_argument);
+}
+
+TEST_F(SQLiteResultSetTest, GetColumnIndexByName) {
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(3));
+    ON_CALL(*mock_, sqlite3_column_name(fake_stmt_, 0)).WillByDefault(Return("id"));
+    ON_CALL(*mock_, sqlite3_column_name(fake_stmt_, 1)).WillByDefault(Return("name"));
+    ON_CALL(*mock_, sqlite3_column_name(fake_stmt_, 2)).WillByDefault(Return("id"));
+
+    EXPECT_EQ(result_set_->column_index("id"), 0);
+    EXPECT_EQ(result_set_->column_index("name"), 1);
+    EXPECT_FALSE(result_set_->metadata()->find("unknown"));
+    EXPECT_THROW((void) result_set_->column_index("unknown"), std::invalid_argument);
+}
+
 TEST_F(SQLiteResultSetTest, GetIntegerFromDifferentDataTypeThrowsException) {
     ON_CALL(*mock_, sqlite3_column_type)
             .WillByDefault(Return(SQLITE_TEXT));
@@ -29,6 +29,7 @@
 using ::testing::DoAll;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 using ::testing::StrEq;
 using ::testing::_; // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
@@ -76,6 +77,9 @@ void SQLiteStatementTest::SetUp() {
     ON_CALL(*mock_, sqlite3_step)
             .WillByDefault(Return(SQLITE_DONE));
 
+    ON_CALL(*mock_, sqlite3_bind_parameter_count)
+            .WillByDefault(Return(10));
+
     database_ = std::make_shared<SQLiteDatabase>("tmp.db");
     statement_ = std::make_shared<SQLiteStatement>(database_, "SQL");
 }
@@ -218,6 +222,116 @@ TEST_F(SQLiteStatementTest, ExecuteInvalidStatemetThrowsException) {
     EXPECT_THROW(statement->execute(), std::logic_error);
 }
 
+TEST_F(SQLiteStatementTest, QueryStatementReturnsCursor) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    Cursor cursor = statement_->query();
+    ASSERT_TRUE(cursor);
+
+    EXPECT_FALSE(cursor.next());
+    EXPECT_FALSE(cursor);
+}
+
+TEST_F(SQLiteStatementTest, QueryStatementReturnsEmptyCursorWhenNoResult) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_DONE));
+
+    Cursor cursor = statement_->query();
+    EXPECT_FALSE(cursor);
+    EXPECT_THROW(*cursor, std::logic_error);
+}
+
+TEST_F(SQLiteStatementTest, QueryStatementTwiceThrowsException) {
+    statement_->query();
+    EXPECT_THROW(statement_->query(), std::logic_error);
+}
+
+TEST_F(SQLiteStatementTest, CursorBecomesStaleAfterReset) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+
+    Cursor cursor = statement_->query();
+    statement_->reset();
+
+    EXPECT_FALSE(cursor.next());
+}
+
+TEST_F(SQLiteStatementTest, CursorKeepsStatementAlive) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    Cursor cursor = statement_->query();
+    std::weak_ptr<SQLiteStatement> statement = statement_;
+    statement_.reset();
+    ASSERT_FALSE(statement.expired());
+
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_stmt_));
+    EXPECT_FALSE(cursor.next());
+    EXPECT_TRUE(statement.expired());
+}
+
+TEST_F(SQLiteStatementTest, IterateRowsOfStatement) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    size_t count = 0;
+    for (auto& row : statement_->rows()) {
+        EXPECT_EQ(row.data_type(0), ResultSet::DataType::INTEGER);
+        count++;
+    }
+
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(SQLiteStatementTest, RowsOfStatementWithoutResultIsEmpty) {
+    auto rows = statement_->rows();
+    EXPECT_EQ(rows.begin(), rows.end());
+}
+
+TEST_F(SQLiteStatementTest, QueryScalarReadsFirstColumnAndResets) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_INTEGER));
+    EXPECT_CALL(*mock_, sqlite3_column_int64(fake_stmt_, 0)).WillOnce(Return(42));
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_));
+
+    EXPECT_EQ(statement_->query_scalar<int64_t>(), 42);
+    EXPECT_TRUE(statement_->pending());
+}
+
+TEST_F(SQLiteStatementTest, QueryScalarWithoutRowsReturnsNothing) {
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_));
+
+    EXPECT_EQ(statement_->query_scalar<int64_t>(), std::nullopt);
+}
+
+TEST_F(SQLiteStatementTest, QueryScalarWithInvalidTypeResetsAndThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_));
+
+    EXPECT_THROW(statement_->query_scalar<int64_t>(), std::invalid_argument);
+    EXPECT_TRUE(statement_->pending());
+}
+
+TEST_F(SQLiteStatementTest, QueryOneReadsColumnsOfFirstRow) {
+    const char* text = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillByDefault(Return(SQLITE_INTEGER));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 0)).WillOnce(Return(7));
+    EXPECT_CALL(*mock_, sqlite3_column_text(fake_stmt_, 1))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(text)));
+
+    auto row = statement_->query_one<std::tuple<int32_t, std::string>>();
+
+    ASSERT_TRUE(row.has_value());
+    EXPECT_EQ(*row, std::make_tuple(7, std::string("Test")));
+}
+
 TEST_F(SQLiteStatementTest, CheckIfStatementIsPending) {
     ASSERT_TRUE(statement_->pending());
 
@@ -228,6 +342,146 @@ TEST_F(SQLiteStatementTest, CheckIfStatementIsPending) {
     EXPECT_FALSE(statement_->pending());
 }
 
+TEST_F(SQLiteStatementTest, ResetStatementCallsSQLite) {
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_));
+    statement_->reset();
+}
+
+TEST_F(SQLiteStatementTest, ResetStatementMakesItPending) {
+    statement_->execute();
+    ASSERT_FALSE(statement_->pending());
+
+    statement_->reset();
+    EXPECT_TRUE(statement_->pending());
+}
+
+TEST_F(SQLiteStatementTest, ExecuteStatementAgainAfterReset) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .Times(2)
+            .WillRepeatedly(Return(SQLITE_DONE));
+
+    statement_->execute();
+    statement_->reset();
+    EXPECT_NO_THROW(statement_->execute());
+}
+
+TEST_F(SQLiteStatementTest, ResetInvalidStatementThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2)
+            .WillOnce(DoAll(SetArgPointee<3>(nullptr), Return(SQLITE_OK)));
+
+    auto statement = std::make_shared<SQLiteStatement>(database_, SQL_QUERY);
+    EXPECT_THROW(statement->reset(), std::logic_error);
+}
+
+TEST_F(SQLiteStatementTest, ClearBindingsCallsSQLite) {
+    EXPECT_CALL(*mock_, sqlite3_clear_bindings(fake_stmt_));
+    statement_->clear_bindings();
+}
+
+TEST_F(SQLiteStatementTest, ClearBindingsOfInvalidStatementThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2)
+            .WillOnce(DoAll(SetArgPointee<3>(nullptr), Return(SQLITE_OK)));
+
+    auto statement = std::make_shared<SQLiteStatement>(database_, SQL_QUERY);
+    EXPECT_THROW(statement->clear_bindings(), std::logic_error);
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchBindsAndExecutesEachRow) {
+    std::vector<std::tuple<int32_t, double>> rows{{1, 0.5}, {2, 1.5}};
+
+    ON_CALL(*mock_, sqlite3_changes)
+            .WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 1));
+    EXPECT_CALL(*mock_, sqlite3_bind_double(fake_stmt_, 2, 0.5));
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 2));
+    EXPECT_CALL(*mock_, sqlite3_bind_double(fake_stmt_, 2, 1.5));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .Times(2)
+            .WillRepeatedly(Return(SQLITE_DONE));
+
+    auto batch = statement_->execute_batch(rows);
+
+    EXPECT_TRUE(batch.succeeded());
+    EXPECT_EQ(batch.changes, std::vector<uint64_t>({1, 1}));
+    EXPECT_TRUE(statement_->pending());
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchWithSingleValueRows) {
+    std::vector<int64_t> rows{10, 20, 30};
+
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, _))
+            .Times(3);
+
+    auto batch = statement_->execute_batch(rows);
+    EXPECT_EQ(batch.changes.size(), 3);
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchRunsWithinTransaction) {
+    std::vector<int32_t> rows{1};
+
+    ON_CALL(*mock_, sqlite3_get_autocommit)
+            .WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_exec(_, StrEq("BEGIN TRANSACTION;"), _, _, _));
+    EXPECT_CALL(*mock_, sqlite3_exec(_, StrEq("COMMIT;"), _, _, _));
+
+    EXPECT_TRUE(statement_->execute_batch(rows).succeeded());
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchWithinOpenTransactionDoesNotBeginTransaction) {
+    std::vector<int32_t> rows{1};
+
+    ON_CALL(*mock_, sqlite3_get_autocommit)
+            .WillByDefault(Return(0));
+
+    EXPECT_CALL(*mock_, sqlite3_exec)
+            .Times(0);
+
+    EXPECT_TRUE(statement_->execute_batch(rows).succeeded());
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchStopsOnFirstFailedRow) {
+    std::vector<int32_t> rows{1, 2, 3};
+
+    ON_CALL(*mock_, sqlite3_get_autocommit)
+            .WillByDefault(Return(1));
+
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_DONE))
+            .WillOnce(Return(SQLITE_CONSTRAINT));
+
+    EXPECT_CALL(*mock_, sqlite3_exec(_, StrEq("BEGIN TRANSACTION;"), _, _, _));
+    EXPECT_CALL(*mock_, sqlite3_exec(_, StrEq("ROLLBACK;"), _, _, _));
+
+    auto batch = statement_->execute_batch(rows);
+
+    ASSERT_FALSE(batch.succeeded());
+    EXPECT_EQ(*batch.failed_row, 1);
+    EXPECT_EQ(batch.changes.size(), 1);
+    EXPECT_THROW(std::rethrow_exception(batch.error), constraint_violation);
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchWithFailedCommitThrowsException) {
+    std::vector<int32_t> rows{1};
+
+    ON_CALL(*mock_, sqlite3_get_autocommit)
+            .WillByDefault(Return(1));
+
+    ON_CALL(*mock_, sqlite3_exec(_, StrEq("COMMIT;"), _, _, _))
+            .WillByDefault(Return(SQLITE_BUSY));
+
+    EXPECT_THROW(statement_->execute_batch(rows), std::logic_error);
+}
+
+TEST_F(SQLiteStatementTest, ExecuteBatchOnInvalidStatementThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v2)
+            .WillOnce(DoAll(SetArgPointee<3>(nullptr), Return(SQLITE_OK)));
+
+    auto statement = std::make_shared<SQLiteStatement>(database_, SQL_QUERY);
+    EXPECT_THROW(statement->execute_batch(std::vector<int32_t>{1}), std::logic_error);
+}
+
 TEST_F(SQLiteStatementTest, BindUnsignedInteger8) {
     check_bind_integer<uint8_t>(20, 2);
 }
@@ -274,13 +528,113 @@ TEST_F(SQLiteStatementTest, BindBool) {
 
 TEST_F(SQLiteStatementTest, BindText) {
     uint16_t index = 2;
-    const char* value = "Test";
+    const std::string value = "Test";
 
     EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, (index + 1), StrEq(value),
-            strlen(value), SQLITE_TRANSIENT))
+            value.size(), SQLITE_TRANSIENT))
             .WillOnce(Return(SQLITE_OK));
 
-    statement_->bind(std::string(value), index);
+    statement_->bind(value, index);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedText) {
+    uint16_t index = 2;
+    std::string value(100, 'x');
+    const char* data = value.data();
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, (index + 1), data, 100, SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(std::move(value), index);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedTextToInvalidIndexThrowsException) {
+    EXPECT_THROW(statement_->bind(std::string("Test"), 10), std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, BindStaticTextView) {
+    uint16_t index = 1;
+    std::string_view value = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, (index + 1), value.data(),
+            value.size(), SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(value, index, Statement::Lifetime::STATIC);
+}
+
+TEST_F(SQLiteStatementTest, BindTransientTextView) {
+    uint16_t index = 1;
+    std::string_view value = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, (index + 1), value.data(),
+            value.size(), SQLITE_TRANSIENT))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(value, index, Statement::Lifetime::TRANSIENT);
+}
+
+TEST_F(SQLiteStatementTest, BindEmptyTextViewBindsEmptyText) {
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 1, StrEq(""), 0, SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(std::string_view(), 0, Statement::Lifetime::STATIC);
+}
+
+TEST_F(SQLiteStatementTest, BindSharedTextRetainsItUntilCleared) {
+    auto value = std::make_shared<const std::string>("Test");
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 1, value->c_str(), value->size(),
+            SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(value, 0);
+    EXPECT_EQ(value.use_count(), 2);
+
+    statement_->clear_bindings();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST_F(SQLiteStatementTest, RebindSharedTextReleasesPreviousValue) {
+    auto value1 = std::make_shared<const std::string>("Test1");
+    auto value2 = std::make_shared<const std::string>("Test2");
+
+    statement_->bind(value1, 0);
+    statement_->bind(value2, 0);
+
+    EXPECT_EQ(value1.use_count(), 1);
+    EXPECT_EQ(value2.use_count(), 2);
+}
+
+TEST_F(SQLiteStatementTest, BindSharedTextWithFailureKeepsPreviousValue) {
+    auto value1 = std::make_shared<const std::string>("Test1");
+    auto value2 = std::make_shared<const std::string>("Test2");
+
+    statement_->bind(value1, 0);
+
+    ON_CALL(*mock_, sqlite3_bind_text).WillByDefault(Return(SQLITE_MISUSE));
+    EXPECT_THROW(statement_->bind(value2, 0), std::invalid_argument);
+
+    // SQLite still refers to the previous value
+    EXPECT_EQ(value1.use_count(), 2);
+    EXPECT_EQ(value2.use_count(), 1);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedTextWithFailureKeepsPreviousValue) {
+    std::string value1(100, 'a');
+    const char* data = value1.data();
+
+    statement_->bind(std::move(value1), 0);
+
+    ON_CALL(*mock_, sqlite3_bind_text).WillByDefault(Return(SQLITE_MISUSE));
+    EXPECT_THROW(statement_->bind(std::string(100, 'b'), 0), std::invalid_argument);
+
+    EXPECT_EQ(std::string(data, 100), std::string(100, 'a'));
+}
+
+TEST_F(SQLiteStatementTest, BindInvalidSharedTextThrowsException) {
+    EXPECT_THROW(statement_->bind(std::shared_ptr<const std::string>(), 0),
+            std::invalid_argument);
 }
 
 TEST_F(SQLiteStatementTest, BindBlob) {
@@ -288,10 +642,236 @@ TEST_F(SQLiteStatementTest, BindBlob) {
     const char* value = "Test";
 
     EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, (index + 1), value,
-            strlen(value), nullptr))
+            strlen(value), SQLITE_STATIC))
             .WillOnce(Return(SQLITE_OK));
 
     statement_->bind(value, strlen(value), index);
 }
 
+TEST_F(SQLiteStatementTest, BindTransientBlob) {
+    uint16_t index = 2;
+    const char* value = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, (index + 1), value,
+            strlen(value), SQLITE_TRANSIENT))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(value, strlen(value), index, Statement::Lifetime::TRANSIENT);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedBlob) {
+    uint16_t index = 1;
+    std::vector<std::byte> value(100);
+    const std::byte* data = value.data();
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, (index + 1), data, 100, SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(std::move(value), index);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedBlobToInvalidIndexThrowsException) {
+    EXPECT_THROW(statement_->bind(std::vector<std::byte>(10), 10), std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, BindOwnedBlobTransfersOwnershipToSQLite) {
+    auto value = std::make_unique<std::byte[]>(100);
+    const std::byte* data = value.get();
+    void (*destructor)(void*) = nullptr;
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, 1, data, 100, _))
+            .WillOnce(DoAll(SaveArg<4>(&destructor), Return(SQLITE_OK)));
+
+    statement_->bind(std::move(value), 100, 0);
+
+    ASSERT_NE(destructor, nullptr);
+    ASSERT_NE(destructor, SQLITE_TRANSIENT);
+    destructor(const_cast<std::byte*>(data));
+}
+
+TEST_F(SQLiteStatementTest, BindTooLargeOwnedBlobThrowsException) {
+    auto value = std::make_unique<std::byte[]>(1);
+    const std::byte* data = value.get();
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob).Times(0);
+
+    EXPECT_THROW(statement_->bind(std::move(value), size_t(1) << 32, 0), std::invalid_argument);
+    EXPECT_EQ(value.get(), data);
+}
+
+TEST_F(SQLiteStatementTest, BindSharedBlobWithFailureKeepsPreviousValue) {
+    auto value1 = std::make_shared<const std::vector<std::byte>>(100);
+    auto value2 = std::make_shared<const std::vector<std::byte>>(100);
+
+    statement_->bind(value1, 0);
+
+    ON_CALL(*mock_, sqlite3_bind_blob).WillByDefault(Return(SQLITE_MISUSE));
+    EXPECT_THROW(statement_->bind(value2, 0), std::invalid_argument);
+
+    // SQLite still refers to the previous value
+    EXPECT_EQ(value1.use_count(), 2);
+    EXPECT_EQ(value2.use_count(), 1);
+}
+
+TEST_F(SQLiteStatementTest, BindMovedBlobWithFailureKeepsPreviousValue) {
+    std::vector<std::byte> value1(100, std::byte(1));
+    const std::byte* data = value1.data();
+
+    statement_->bind(std::move(value1), 0);
+
+    ON_CALL(*mock_, sqlite3_bind_blob).WillByDefault(Return(SQLITE_MISUSE));
+    EXPECT_THROW(statement_->bind(std::vector<std::byte>(100), 0), std::invalid_argument);
+
+    EXPECT_EQ(data[99], std::byte(1));
+}
+
+TEST_F(SQLiteStatementTest, BindSharedBlobRetainsItUntilCleared) {
+    auto value = std::make_shared<const std::vector<std::byte>>(100);
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, 1, value->data(), 100, SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(value, 0);
+    EXPECT_EQ(value.use_count(), 2);
+
+    statement_->clear_bindings();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST_F(SQLiteStatementTest, BindInvalidSharedBlobThrowsException) {
+    EXPECT_THROW(statement_->bind(std::shared_ptr<const std::vector<std::byte>>(), 0),
+            std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, BindZeroBlob) {
+    EXPECT_CALL(*mock_, sqlite3_bind_zeroblob64(fake_stmt_, 2, 1 << 20))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind_zeroblob(1 << 20, 1);
+}
+
+TEST_F(SQLiteStatementTest, BindNull) {
+    EXPECT_CALL(*mock_, sqlite3_bind_null(fake_stmt_, 3))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(std::nullopt, 2);
+}
+
+TEST_F(SQLiteStatementTest, BindOptionalBindsValueOrNull) {
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 5))
+            .WillOnce(Return(SQLITE_OK));
+    EXPECT_CALL(*mock_, sqlite3_bind_null(fake_stmt_, 2))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(std::optional<int64_t>(5), 0);
+    statement_->bind(std::optional<int64_t>(), 1);
+}
+
+TEST_F(SQLiteStatementTest, BindNullWithFailureThrowsException) {
+    ON_CALL(*mock_, sqlite3_bind_null)
+            .WillByDefault(Return(SQLITE_RANGE));
+
+    EXPECT_THROW(statement_->bind(std::nullopt, 0), std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, BindAllBindsValuesInOrder) {
+    std::string text = "Text";
+
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, -5));
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 2, 4294967295));
+    EXPECT_CALL(*mock_, sqlite3_bind_double(fake_stmt_, 3, 0.25));
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 4, text.c_str(), text.size(),
+            SQLITE_STATIC));
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 5, StrEq("Literal"), 7,
+            SQLITE_STATIC));
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 6, 1));
+
+    statement_->bind_all(int8_t(-5), uint32_t(4294967295), 0.25f, text, "Literal", true);
+}
+
+TEST_F(SQLiteStatementTest, BindAllBindsBlob) {
+    std::vector<std::byte> blob{std::byte(1), std::byte(2)};
+
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, 1, blob.data(), blob.size(),
+            SQLITE_STATIC));
+
+    statement_->bind_all(blob);
+}
+
+TEST_F(SQLiteStatementTest, BindAllBindsEmptyTextAndBlob) {
+    std::string_view text;
+    std::vector<std::byte> blob;
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 1, StrEq(""), 0, SQLITE_STATIC));
+    EXPECT_CALL(*mock_, sqlite3_bind_blob(fake_stmt_, 2, ::testing::NotNull(), 0,
+            SQLITE_STATIC));
+    EXPECT_CALL(*mock_, sqlite3_bind_null).Times(0);
+
+    statement_->bind_all(text, blob);
+}
+
+TEST_F(SQLiteStatementTest, BindAllBindsNull) {
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 1));
+    EXPECT_CALL(*mock_, sqlite3_bind_null(fake_stmt_, 2));
+    EXPECT_CALL(*mock_, sqlite3_bind_null(fake_stmt_, 3));
+    EXPECT_CALL(*mock_, sqlite3_bind_double(fake_stmt_, 4, 0.5));
+
+    std::optional<std::string> text;
+
+    statement_->bind_all(1, std::nullopt, text, std::optional<double>(0.5));
+}
+
+TEST_F(SQLiteStatementTest, BindTupleBindsElementsInOrder) {
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 7));
+    EXPECT_CALL(*mock_, sqlite3_bind_double(fake_stmt_, 2, 1.5));
+
+    statement_->bind_tuple(std::make_tuple(7, 1.5));
+}
+
+TEST_F(SQLiteStatementTest, BindAllWithFailureThrowsException) {
+    ON_CALL(*mock_, sqlite3_bind_int64)
+            .WillByDefault(Return(SQLITE_RANGE));
+
+    EXPECT_THROW(statement_->bind_all(1, 2), std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, ConstructorMapsNamedParameters) {
+    ON_CALL(*mock_, sqlite3_bind_parameter_count)
+            .WillByDefault(Return(3));
+
+    EXPECT_CALL(*mock_, sqlite3_bind_parameter_name(fake_stmt_, 1))
+            .WillOnce(Return(":id"));
+    EXPECT_CALL(*mock_, sqlite3_bind_parameter_name(fake_stmt_, 2))
+            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*mock_, sqlite3_bind_parameter_name(fake_stmt_, 3))
+            .WillOnce(Return("@name"));
+
+    auto statement = std::make_shared<SQLiteStatement>(database_, SQL_QUERY);
+
+    EXPECT_EQ(statement->parameter_index(":id"), 0);
+    EXPECT_EQ(statement->parameter_index("@name"), 2);
+}
+
+TEST_F(SQLiteStatementTest, GetIndexOfUnknownParameterThrowsException) {
+    EXPECT_THROW(static_cast<void>(statement_->parameter_index(":unknown")),
+            std::invalid_argument);
+}
+
+TEST_F(SQLiteStatementTest, BindNamedParameter) {
+    ON_CALL(*mock_, sqlite3_bind_parameter_count)
+            .WillByDefault(Return(2));
+    ON_CALL(*mock_, sqlite3_bind_parameter_name(_, 1))
+            .WillByDefault(Return(":id"));
+    ON_CALL(*mock_, sqlite3_bind_parameter_name(_, 2))
+            .WillByDefault(Return(":name"));
+
+    auto statement = std::make_shared<SQLiteStatement>(database_, SQL_QUERY);
+
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 10));
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 2, StrEq("Name"), 4, SQLITE_STATIC));
+
+    statement->bind(10, ":id");
+    statement->bind("Name", ":name");
+}
+
 } // namespace cppdbc
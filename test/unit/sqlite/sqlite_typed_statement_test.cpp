@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2020 Gustavo Salomao
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include "cppdbc/sqlite/sqlite_typed_statement.hpp"
+#include "mock/sqlite3_mock.hpp"
+
+using ::testing::DoAll;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::StrEq;
+using ::testing::_; // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+namespace cppdbc {
+
+using TypedStatement = SQLiteTypedStatement<std::tuple<int64_t, std::string>,
+        std::tuple<int32_t, std::string, std::optional<double>>>;
+
+class SQLiteTypedStatementTest : public ::testing::Test {
+protected:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    sqlite3* fake_sqlite_{nullptr};
+    sqlite3_stmt* fake_stmt_{nullptr};
+
+    std::shared_ptr<SQLite3Mock> mock_;
+    std::shared_ptr<SQLiteDatabase> database_;
+    std::unique_ptr<TypedStatement> statement_;
+};
+
+void SQLiteTypedStatementTest::SetUp() {
+    mock_ = std::make_shared<NiceMock<SQLite3Mock>>();
+    SQLite3Mock::register_mock(mock_);
+
+    fake_sqlite_ = reinterpret_cast<sqlite3*>(new int(1));
+    fake_stmt_ = reinterpret_cast<sqlite3_stmt*>(new int(1));
+
+    ON_CALL(*mock_, sqlite3_open_v2)
+            .WillByDefault(DoAll(SetArgPointee<1>(fake_sqlite_), Return(SQLITE_OK)));
+
+    ON_CALL(*mock_, sqlite3_prepare_v3)
+            .WillByDefault(DoAll(SetArgPointee<4>(fake_stmt_), Return(SQLITE_OK)));
+
+    ON_CALL(*mock_, sqlite3_step).WillByDefault(Return(SQLITE_DONE));
+    ON_CALL(*mock_, sqlite3_bind_parameter_count).WillByDefault(Return(2));
+    ON_CALL(*mock_, sqlite3_column_count).WillByDefault(Return(3));
+
+    database_ = std::make_shared<SQLiteDatabase>("tmp.db");
+    statement_ = std::make_unique<TypedStatement>(database_, "SQL");
+}
+
+void SQLiteTypedStatementTest::TearDown() {
+    statement_.reset();
+    database_.reset();
+
+    delete reinterpret_cast<int*>(fake_stmt_);
+    delete reinterpret_cast<int*>(fake_sqlite_);
+    SQLite3Mock::destroy();
+}
+
+TEST_F(SQLiteTypedStatementTest, ConstructorPreparesPersistentStatement) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3(fake_sqlite_, StrEq("SQL"), 3,
+            SQLITE_PREPARE_PERSISTENT, _, _))
+            .WillOnce(DoAll(SetArgPointee<4>(fake_stmt_), Return(SQLITE_OK)));
+
+    TypedStatement statement(database_, "SQL");
+}
+
+TEST_F(SQLiteTypedStatementTest, ConstructorWithInvalidDatabaseThrowsException) {
+    EXPECT_THROW(TypedStatement(nullptr, "SQL"), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, ConstructorWithInvalidQueryThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_prepare_v3).WillOnce(Return(SQLITE_ERROR));
+
+    EXPECT_THROW(TypedStatement(database_, "SQL"), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, ConstructorWithMismatchedColumnsThrowsException) {
+    statement_.reset();
+
+    EXPECT_CALL(*mock_, sqlite3_column_count).WillOnce(Return(2));
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_stmt_));
+
+    EXPECT_THROW(TypedStatement(database_, "SQL"), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, DestructorFinalizesStatement) {
+    EXPECT_CALL(*mock_, sqlite3_finalize(fake_stmt_));
+    statement_.reset();
+}
+
+TEST_F(SQLiteTypedStatementTest, BindCopiesParameters) {
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_));
+    EXPECT_CALL(*mock_, sqlite3_bind_int64(fake_stmt_, 1, 7)).WillOnce(Return(SQLITE_OK));
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 2, StrEq("Test"), 4, SQLITE_TRANSIENT))
+            .WillOnce(Return(SQLITE_OK));
+
+    statement_->bind(7, "Test");
+}
+
+TEST_F(SQLiteTypedStatementTest, BindWithFailureThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_bind_int64).WillOnce(Return(SQLITE_RANGE));
+    EXPECT_CALL(*mock_, sqlite3_bind_text).Times(0);
+
+    EXPECT_THROW(statement_->bind(7, "Test"), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, NextReturnsIfRowIsAvailable) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_))
+            .WillOnce(Return(SQLITE_ROW))
+            .WillOnce(Return(SQLITE_DONE));
+
+    EXPECT_TRUE(statement_->next());
+    EXPECT_FALSE(statement_->next());
+}
+
+TEST_F(SQLiteTypedStatementTest, NextViolatingConstraintThrowsException) {
+    EXPECT_CALL(*mock_, sqlite3_step).WillOnce(Return(SQLITE_CONSTRAINT));
+
+    EXPECT_THROW(statement_->next(), constraint_violation);
+}
+
+TEST_F(SQLiteTypedStatementTest, RowReadsColumns) {
+    const char* text = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 0)).WillOnce(Return(5));
+    EXPECT_CALL(*mock_, sqlite3_column_text(fake_stmt_, 1))
+            .WillOnce(Return(reinterpret_cast<const unsigned char*>(text)));
+    EXPECT_CALL(*mock_, sqlite3_column_bytes(fake_stmt_, 1)).WillOnce(Return(4));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_INTEGER));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillOnce(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 2)).WillOnce(Return(SQLITE_NULL));
+
+    auto [id, name, value] = statement_->row();
+
+    EXPECT_EQ(id, 5);
+    EXPECT_EQ(name, "Test");
+    EXPECT_FALSE(value.has_value());
+}
+
+TEST_F(SQLiteTypedStatementTest, RowAsAggregate) {
+    struct Record {
+        int32_t id;
+        std::string name;
+        std::optional<double> value;
+    };
+
+    EXPECT_CALL(*mock_, sqlite3_column_int(fake_stmt_, 0)).WillOnce(Return(5));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillOnce(Return(SQLITE_INTEGER));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillOnce(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_type(fake_stmt_, 2)).WillOnce(Return(SQLITE_FLOAT));
+    EXPECT_CALL(*mock_, sqlite3_column_double(fake_stmt_, 2)).WillOnce(Return(1.5));
+
+    auto record = statement_->row_as<Record>();
+
+    EXPECT_EQ(record.id, 5);
+    EXPECT_EQ(record.name, "");
+    EXPECT_DOUBLE_EQ(record.value.value(), 1.5);
+}
+
+TEST_F(SQLiteTypedStatementTest, RowWithColumnOfOtherTypeThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillByDefault(Return(SQLITE_TEXT));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    EXPECT_CALL(*mock_, sqlite3_column_int).Times(0);
+
+    EXPECT_THROW(statement_->row(), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, RowWithNullInNonOptionalColumnThrowsException) {
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillByDefault(Return(SQLITE_NULL));
+
+    EXPECT_THROW(statement_->row(), std::invalid_argument);
+}
+
+TEST_F(SQLiteTypedStatementTest, ExecuteBindsWithoutCopyAndResets) {
+    std::string text = "Test";
+
+    EXPECT_CALL(*mock_, sqlite3_bind_text(fake_stmt_, 2, text.data(), 4, SQLITE_STATIC))
+            .WillOnce(Return(SQLITE_OK));
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_DONE));
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_)).Times(2);
+    EXPECT_CALL(*mock_, sqlite3_changes(fake_sqlite_)).WillOnce(Return(1));
+    EXPECT_CALL(*mock_, sqlite3_clear_bindings(fake_stmt_));
+
+    EXPECT_EQ(statement_->execute(7, text), 1);
+}
+
+TEST_F(SQLiteTypedStatementTest, ExecuteWithFailureClearsBindings) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_CONSTRAINT));
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_)).Times(2);
+    EXPECT_CALL(*mock_, sqlite3_clear_bindings(fake_stmt_));
+
+    EXPECT_THROW(statement_->execute(7, std::string("Test")), constraint_violation);
+}
+
+TEST_F(SQLiteTypedStatementTest, ForEachResetsStatementWhenFunctionThrows) {
+    EXPECT_CALL(*mock_, sqlite3_step(fake_stmt_)).WillOnce(Return(SQLITE_ROW));
+    EXPECT_CALL(*mock_, sqlite3_reset(fake_stmt_)).Times(2);
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 0)).WillByDefault(Return(SQLITE_INTEGER));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 1)).WillByDefault(Return(SQLITE_TEXT));
+    ON_CALL(*mock_, sqlite3_column_type(fake_stmt_, 2)).WillByDefault(Return(SQLITE_NULL));
+
+    EXPECT_THROW(statement_->for_each([](int32_t, const std::string&, std::optional<double>) {
+        throw std::runtime_error("Failure");
+    }, 7, "Test"), std::runtime_error);
+}
+
+} // namespace cppdbc